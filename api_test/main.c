@@ -1,3 +1,4 @@
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -5,6 +6,7 @@
 #define CMARK_NO_SHORT_NAMES
 #include "cmark-gfm.h"
 #include "node.h"
+#include "houdini.h"
 #include "../extensions/cmark-gfm-core-extensions.h"
 
 #include "harness.h"
@@ -276,6 +278,33 @@ static void iterator(test_batch_runner *runner) {
   cmark_node_free(doc);
 }
 
+static void iterator_init(test_batch_runner *runner) {
+  static const char md[] = "> a *b*\n\n---\n\n- `c`\n";
+  cmark_node *doc = cmark_parse_document(md, sizeof(md) - 1, CMARK_OPT_DEFAULT);
+  cmark_iter *heap = cmark_iter_new(doc);
+  cmark_iter_storage storage;
+  cmark_iter *stack = cmark_iter_init(&storage, doc);
+  cmark_event_type ev_type;
+  int events = 0, mismatches = 0;
+
+  while ((ev_type = cmark_iter_next(heap)) != CMARK_EVENT_DONE) {
+    if (cmark_iter_next(stack) != ev_type ||
+        cmark_iter_get_node(stack) != cmark_iter_get_node(heap))
+      mismatches++;
+    events++;
+  }
+  INT_EQ(runner, cmark_iter_next(stack), CMARK_EVENT_DONE,
+         "stack iterator is done with the heap iterator");
+  INT_EQ(runner, events, 18, "iterate over every event");
+  INT_EQ(runner, mismatches, 0, "stack iterator walks like a heap iterator");
+  OK(runner, cmark_iter_get_root(stack) == doc, "stack iterator root");
+  OK(runner, cmark_iter_init(&storage, NULL) == NULL,
+     "no stack iterator without root");
+
+  cmark_iter_free(heap);
+  cmark_node_free(doc);
+}
+
 static void iterator_delete(test_batch_runner *runner) {
   static const char md[] = "a *b* c\n"
                            "\n"
@@ -694,6 +723,22 @@ static void render_commonmark(test_batch_runner *runner) {
 
   cmark_node_free(text);
   cmark_node_free(doc);
+
+  // Characters to escape in the middle of plain text, wrapped under a
+  // prefix.
+  static const char escapes[] = "> - a line of *plain* words that wraps 10. "
+                                "- + = more\\\\ & text_with ~tilde\n";
+  doc = cmark_parse_document(escapes, sizeof(escapes) - 1, CMARK_OPT_DEFAULT);
+  commonmark = cmark_render_commonmark(doc, CMARK_OPT_DEFAULT, 20);
+  STR_EQ(runner, commonmark, ">   - a line of\n"
+                             ">     *plain* words\n"
+                             ">     that wraps 10.\n"
+                             ">     - + = more\\\\ &\n"
+                             ">     text\\_with\n"
+                             ">     \\~tilde\n",
+         "render escapes with wrapping");
+  free(commonmark);
+  cmark_node_free(doc);
 }
 
 static void render_plaintext(test_batch_runner *runner) {
@@ -872,6 +917,63 @@ static void line_endings(test_batch_runner *runner) {
   free(html);
 }
 
+static void html_block_lines(test_batch_runner *runner) {
+  // Lines of an open HTML block are appended in bulk; line endings,
+  // NULs and line numbers must come out as if fed line by line.
+  static const char chunk1[] = "<!--\r\na\0b\r";
+  static const char chunk2[] = "\nc\rd\n-->\ntext\n<script>\nx\n</SCRIPT> y\nz\n";
+  cmark_parser *parser = cmark_parser_new(CMARK_OPT_UNSAFE);
+  cmark_parser_feed(parser, chunk1, sizeof(chunk1) - 1);
+  cmark_parser_feed(parser, chunk2, sizeof(chunk2) - 1);
+  cmark_node *doc = cmark_parser_finish(parser);
+  char *html = cmark_render_html(doc, CMARK_OPT_UNSAFE, NULL);
+  STR_EQ(runner, html,
+         "<!--\na" UTF8_REPL "b\nc\nd\n-->\n"
+         "<p>text</p>\n"
+         "<script>\nx\n</SCRIPT> y\n"
+         "<p>z</p>\n",
+         "HTML block lines fed across chunks");
+  free(html);
+
+  cmark_node *para = cmark_node_next(cmark_node_first_child(doc));
+  INT_EQ(runner, cmark_node_get_start_line(para), 6,
+         "line numbers after HTML block");
+  INT_EQ(runner, cmark_node_get_start_line(cmark_node_last_child(doc)), 10,
+         "line numbers after second HTML block");
+
+  cmark_node_free(doc);
+  cmark_parser_free(parser);
+}
+
+static void leaf_line_runs(test_batch_runner *runner) {
+  // Continuation lines of paragraphs and fenced code are appended in
+  // bulk; the result must match feeding them line by line.
+  static const char chunk1[] = "para\r\nmore a\0b\rlast\n\n``` c\n  x\r\n";
+  static const char chunk2[] = "y\n ``\n```\nz\n";
+  cmark_parser *parser = cmark_parser_new(CMARK_OPT_DEFAULT);
+  cmark_parser_feed(parser, chunk1, sizeof(chunk1) - 1);
+  cmark_parser_feed(parser, chunk2, sizeof(chunk2) - 1);
+  cmark_node *doc = cmark_parser_finish(parser);
+  char *html = cmark_render_html(doc, CMARK_OPT_DEFAULT, NULL);
+  STR_EQ(runner, html,
+         "<p>para\nmore a" UTF8_REPL "b\nlast</p>\n"
+         "<pre><code class=\"language-c\">  x\ny\n ``\n</code></pre>\n"
+         "<p>z</p>\n",
+         "leaf block lines fed across chunks");
+  free(html);
+
+  cmark_node *para = cmark_node_first_child(doc);
+  INT_EQ(runner, cmark_node_get_end_line(para), 3, "paragraph end line");
+  INT_EQ(runner, cmark_node_get_end_column(para), 4, "paragraph end column");
+  INT_EQ(runner, cmark_node_get_end_line(cmark_node_next(para)), 9,
+         "fenced code end line");
+  INT_EQ(runner, cmark_node_get_start_line(cmark_node_last_child(doc)), 10,
+         "line numbers after fenced code");
+
+  cmark_node_free(doc);
+  cmark_parser_free(parser);
+}
+
 static void numeric_entities(test_batch_runner *runner) {
   test_md_to_html(runner, "&#0;", "<p>" UTF8_REPL "</p>\n",
                   "Invalid numeric entity 0");
@@ -904,6 +1006,99 @@ static void numeric_entities(test_batch_runner *runner) {
                   "Max hexadecimal entity length");
 }
 
+// Escapes 'src' one byte at a time, as the escaping functions did before
+// they used the scanners.
+static void naive_escape(cmark_strbuf *ob, const unsigned char *src,
+                         bufsize_t size, int mode) {
+  static const char href_safe[] = "-_.+!*(),%#@?=;:/$~";
+  bufsize_t i;
+  char hex[4];
+
+  for (i = 0; i < size; i++) {
+    unsigned char c = src[i];
+
+    if (mode == 2) {
+      if (c == '&')
+        cmark_strbuf_puts(ob, "&amp;");
+      else if (c == '\'')
+        cmark_strbuf_puts(ob, "&#x27;");
+      else if (c && c < 0x80 && (isalnum(c) || strchr(href_safe, c)))
+        cmark_strbuf_putc(ob, c);
+      else {
+        snprintf(hex, sizeof(hex), "%%%02X", c);
+        cmark_strbuf_puts(ob, hex);
+      }
+    } else if (c == '"') {
+      cmark_strbuf_puts(ob, "&quot;");
+    } else if (c == '&') {
+      cmark_strbuf_puts(ob, "&amp;");
+    } else if (c == '<') {
+      cmark_strbuf_puts(ob, "&lt;");
+    } else if (c == '>') {
+      cmark_strbuf_puts(ob, "&gt;");
+    } else if (mode == 1 && c == '\'') {
+      cmark_strbuf_puts(ob, "&#39;");
+    } else if (mode == 1 && c == '/') {
+      cmark_strbuf_puts(ob, "&#47;");
+    } else {
+      cmark_strbuf_putc(ob, c);
+    }
+  }
+}
+
+static void escape_scan_impls(test_batch_runner *runner) {
+  static const char *names[] = {"auto", "scalar", "ssse3", "avx2"};
+  houdini_scan_impl detected = houdini_get_scan_impl();
+  unsigned char src[600];
+  cmark_strbuf got, expected;
+  int impl, mode, i;
+
+  cmark_strbuf_init(cmark_get_default_mem_allocator(), &got, 0);
+  cmark_strbuf_init(cmark_get_default_mem_allocator(), &expected, 0);
+
+  // Every byte value, then long clean runs, so that each byte needing
+  // escaping is seen at every position of a 16- and 32-byte block.
+  for (i = 0; i < 256; i++)
+    src[i] = (unsigned char)i;
+  for (i = 256; i < (int)sizeof(src); i++)
+    src[i] = (i % 41 == 0) ? "\"&<>'/ \x80"[i % 8] : 'a' + i % 26;
+
+  for (impl = HOUDINI_SCAN_SCALAR; impl <= HOUDINI_SCAN_AVX2; impl++) {
+    int mismatches = 0;
+
+    if (!houdini_set_scan_impl((houdini_scan_impl)impl)) {
+      SKIP(runner, 1);
+      continue;
+    }
+    INT_EQ(runner, houdini_get_scan_impl(), impl, "forced %s scanner",
+           names[impl]);
+
+    for (mode = 0; mode < 3; mode++) {
+      for (i = 0; i < (int)sizeof(src); i += 7) {
+        bufsize_t len = (bufsize_t)sizeof(src) - i;
+
+        cmark_strbuf_clear(&got);
+        cmark_strbuf_clear(&expected);
+        if (mode == 2)
+          houdini_escape_href(&got, src + i, len);
+        else
+          houdini_escape_html0(&got, src + i, len, mode);
+        naive_escape(&expected, src + i, len, mode);
+        if (cmark_strbuf_cmp(&got, &expected) != 0)
+          mismatches++;
+      }
+    }
+    INT_EQ(runner, mismatches, 0, "%s scanner escapes like the naive loop",
+           names[impl]);
+  }
+
+  houdini_set_scan_impl(HOUDINI_SCAN_AUTO);
+  INT_EQ(runner, houdini_get_scan_impl(), detected, "auto scanner restored");
+
+  cmark_strbuf_free(&got);
+  cmark_strbuf_free(&expected);
+}
+
 static void test_safe(test_batch_runner *runner) {
   // Test safe mode
   static const char raw_html[] = "<div>\nhi\n</div>\n\n<a>hi</"
@@ -1105,6 +1300,55 @@ static void source_pos_inlines(test_batch_runner *runner) {
   }
 }
 
+static void text_runs(test_batch_runner *runner) {
+  // Literal runs interrupted by special characters come out as one text
+  // node straight from the parser.
+  static const char markdown[] = "a \\* b [c] &amp; d_e *f\n";
+  cmark_node *doc = cmark_parse_document(markdown, sizeof(markdown) - 1,
+                                         CMARK_OPT_DEFAULT);
+  cmark_node *para = cmark_node_first_child(doc);
+  cmark_node *text = cmark_node_first_child(para);
+  INT_EQ(runner, cmark_node_get_type(text), CMARK_NODE_TEXT,
+         "text run is a text node");
+  STR_EQ(runner, cmark_node_get_literal(text), "a * b [c] & d_e *f",
+         "text run literal");
+  INT_EQ(runner, cmark_node_get_end_column(text), 23, "text run end column");
+  OK(runner, cmark_node_next(text) == NULL, "text run is a single node");
+  cmark_node_free(doc);
+}
+
+static void literal_flags(test_batch_runner *runner) {
+  static const char markdown[] = "plain *\xC3\xA9* a > b `x<y` `ok`\n";
+  const int both = CMARK_CHUNK_NO_HTML_SPECIAL | CMARK_CHUNK_ASCII;
+  cmark_node *doc = cmark_parse_document(markdown, sizeof(markdown) - 1,
+                                         CMARK_OPT_DEFAULT);
+  cmark_node *plain = cmark_node_first_child(cmark_node_first_child(doc));
+  cmark_node *emph = cmark_node_next(plain);
+  cmark_node *gt = cmark_node_next(emph);
+  cmark_node *code = cmark_node_next(gt);
+  cmark_node *ok = cmark_node_next(cmark_node_next(code));
+  char *html;
+
+  INT_EQ(runner, plain->as.literal.flags, both, "plain text flags");
+  INT_EQ(runner, cmark_node_first_child(emph)->as.literal.flags,
+         CMARK_CHUNK_NO_HTML_SPECIAL, "non-ASCII text flags");
+  INT_EQ(runner, gt->as.literal.flags, CMARK_CHUNK_ASCII,
+         "text with '>' flags");
+  INT_EQ(runner, code->as.literal.flags, CMARK_CHUNK_ASCII,
+         "code with '<' flags");
+  INT_EQ(runner, ok->as.literal.flags, both, "plain code flags");
+
+  cmark_node_set_literal(plain, "<b> ");
+  INT_EQ(runner, plain->as.literal.flags, 0, "new literal has no flags");
+  html = cmark_render_html(doc, CMARK_OPT_DEFAULT, NULL);
+  STR_EQ(runner, html,
+         "<p>&lt;b&gt; <em>\xC3\xA9</em> a &gt; b <code>x&lt;y</code> "
+         "<code>ok</code></p>\n",
+         "literals are escaped unless flagged clean");
+  free(html);
+  cmark_node_free(doc);
+}
+
 static void ref_source_pos(test_batch_runner *runner) {
   static const char markdown[] =
     "Let's try [reference] links.\n"
@@ -1129,6 +1373,792 @@ static void ref_source_pos(test_batch_runner *runner) {
   cmark_node_free(doc);
 }
 
+static void excerpt(test_batch_runner *runner) {
+  static const char markdown[] = "# Title\n"
+                                 "\n"
+                                 "> quoted *text*\n"
+                                 "> - one\n"
+                                 "> - two\n"
+                                 "\n"
+                                 "last\n"
+                                 "paragraph\n";
+  cmark_parser *parser = cmark_parser_new(CMARK_OPT_DEFAULT);
+  cmark_node *doc;
+  char *html;
+  int truncated = -1;
+
+  cmark_parser_set_max_blocks(parser, 2);
+  cmark_parser_feed(parser, markdown, sizeof(markdown) - 1);
+  doc = cmark_parser_finish(parser);
+  INT_EQ(runner, cmark_node_get_truncated(doc), 1, "document is truncated");
+  html = cmark_render_html(doc, CMARK_OPT_DEFAULT, NULL);
+  STR_EQ(runner, html,
+         "<h1>Title</h1>\n"
+         "<blockquote>\n"
+         "<p>quoted <em>text</em></p>\n"
+         "<ul>\n"
+         "<li>one</li>\n"
+         "<li>two</li>\n"
+         "</ul>\n"
+         "</blockquote>\n",
+         "max_blocks keeps the first blocks");
+  free(html);
+  cmark_node_free(doc);
+
+  // The limit survives the parser reset in cmark_parser_finish.
+  cmark_parser_feed(parser, "a\n\nb\n\nc\n", 9);
+  doc = cmark_parser_finish(parser);
+  html = cmark_render_html(doc, CMARK_OPT_DEFAULT, NULL);
+  STR_EQ(runner, html, "<p>a</p>\n<p>b</p>\n", "max_blocks is persistent");
+  free(html);
+  cmark_node_free(doc);
+
+  // Reference definitions alone produce no block.
+  cmark_parser_set_max_blocks(parser, 1);
+  cmark_parser_feed(parser, "[a]: /u\n\n[a]\n\nnext\n", 19);
+  doc = cmark_parser_finish(parser);
+  INT_EQ(runner, cmark_node_get_truncated(doc), 1,
+         "document with references is truncated");
+  html = cmark_render_html(doc, CMARK_OPT_DEFAULT, NULL);
+  STR_EQ(runner, html, "<p><a href=\"/u\">a</a></p>\n",
+         "reference definitions don't count as blocks");
+  free(html);
+  cmark_node_free(doc);
+
+  cmark_parser_set_max_blocks(parser, 5);
+  cmark_parser_feed(parser, markdown, sizeof(markdown) - 1);
+  doc = cmark_parser_finish(parser);
+  INT_EQ(runner, cmark_node_get_truncated(doc), 0,
+         "document within budget is not truncated");
+
+  html = cmark_render_html_excerpt(doc, CMARK_OPT_DEFAULT, NULL, 32,
+                                   &truncated);
+  STR_EQ(runner, html,
+         "<h1>Title</h1>\n"
+         "<blockquote>\n"
+         "<p>q</p>\n"
+         "</blockquote>\n",
+         "excerpt closes open elements");
+  INT_EQ(runner, truncated, 1, "excerpt reports truncation");
+  free(html);
+
+  html = cmark_render_html_excerpt(doc, CMARK_OPT_DEFAULT, NULL, 1000,
+                                   &truncated);
+  STR_EQ(runner, html,
+         "<h1>Title</h1>\n"
+         "<blockquote>\n"
+         "<p>quoted <em>text</em></p>\n"
+         "<ul>\n"
+         "<li>one</li>\n"
+         "<li>two</li>\n"
+         "</ul>\n"
+         "</blockquote>\n"
+         "<p>last\nparagraph</p>\n",
+         "excerpt within budget renders everything");
+  INT_EQ(runner, truncated, 0, "excerpt within budget is not truncated");
+  free(html);
+
+  cmark_node_free(doc);
+  cmark_parser_free(parser);
+
+  // Literals are cut at the budget, between characters.
+  doc = cmark_parse_document("    \xc3\xa9\xc3\xa9\xc3\xa9\n\nnext\n", 17,
+                             CMARK_OPT_DEFAULT);
+  html = cmark_render_html_excerpt(doc, CMARK_OPT_DEFAULT, NULL, 16,
+                                   &truncated);
+  STR_EQ(runner, html, "<pre><code>\xc3\xa9\xc3\xa9</code></pre>\n",
+         "excerpt cuts long code blocks");
+  INT_EQ(runner, truncated, 1, "excerpt with a cut literal is truncated");
+  free(html);
+  cmark_node_free(doc);
+
+  // Raw HTML is left out instead.
+  doc = cmark_parse_document("a\n\n<div>long</div>\n", 19,
+                             CMARK_OPT_UNSAFE);
+  html = cmark_render_html_excerpt(doc, CMARK_OPT_UNSAFE, NULL, 10,
+                                   &truncated);
+  STR_EQ(runner, html, "<p>a</p>\n", "excerpt leaves out long raw HTML");
+  INT_EQ(runner, truncated, 1, "excerpt without raw HTML is truncated");
+  free(html);
+  cmark_node_free(doc);
+}
+
+typedef struct {
+  cmark_strbuf out;
+  int calls;
+  int fail_after;
+} html_sink;
+
+static int collect_html(const char *data, size_t len, void *user_data) {
+  html_sink *sink = (html_sink *)user_data;
+
+  if (sink->fail_after && sink->calls == sink->fail_after)
+    return -1;
+  sink->calls++;
+  cmark_strbuf_put(&sink->out, (const unsigned char *)data, (bufsize_t)len);
+  return 0;
+}
+
+static void html_writer(test_batch_runner *runner) {
+  cmark_mem *mem = cmark_get_default_mem_allocator();
+  cmark_strbuf md;
+  html_sink sink;
+  cmark_node *doc;
+  char line[64];
+  char *html;
+  int i;
+
+  cmark_strbuf_init(mem, &md, 0);
+  cmark_strbuf_init(mem, &sink.out, 0);
+  sink.calls = 0;
+  sink.fail_after = 0;
+
+  // Enough blocks for several flushes, with a footnote section at the end.
+  for (i = 0; i < 2000; i++) {
+    snprintf(line, sizeof(line), "para %d *a & b*[^%d]\n\n- item\n\n", i,
+             i % 7);
+    cmark_strbuf_puts(&md, line);
+  }
+  for (i = 0; i < 7; i++) {
+    snprintf(line, sizeof(line), "[^%d]: note %d\n", i, i);
+    cmark_strbuf_puts(&md, line);
+  }
+  doc = cmark_parse_document((const char *)md.ptr, (size_t)md.size,
+                             CMARK_OPT_FOOTNOTES);
+  html = cmark_render_html(doc, CMARK_OPT_DEFAULT, NULL);
+
+  INT_EQ(runner,
+         cmark_render_html_to_writer(doc, CMARK_OPT_DEFAULT, NULL,
+                                     collect_html, &sink),
+         1, "render to writer succeeds");
+  OK(runner, sink.calls > 1, "writer output comes in several pieces");
+  OK(runner,
+     (size_t)sink.out.size == strlen(html) &&
+         memcmp(sink.out.ptr, html, strlen(html)) == 0,
+     "writer output matches cmark_render_html");
+
+  cmark_strbuf_clear(&sink.out);
+  sink.calls = 0;
+  sink.fail_after = 1;
+  INT_EQ(runner,
+         cmark_render_html_to_writer(doc, CMARK_OPT_DEFAULT, NULL,
+                                     collect_html, &sink),
+         0, "writer error is reported");
+  INT_EQ(runner, sink.calls, 1, "writer error stops rendering");
+  cmark_node_free(doc);
+
+  free(html);
+  cmark_strbuf_free(&sink.out);
+  cmark_strbuf_free(&md);
+}
+
+// Uses the public API only.
+static void html_buffer(test_batch_runner *runner) {
+  static const char markdown[] = "# Title\n\nsome *text*\n";
+  cmark_html_buffer *buffer = cmark_html_buffer_new();
+  cmark_node *doc = cmark_parse_document(markdown, sizeof(markdown) - 1,
+                                         CMARK_OPT_DEFAULT);
+  char *html = cmark_render_html(doc, CMARK_OPT_DEFAULT, NULL);
+
+  STR_EQ(runner, cmark_html_buffer_data(buffer), "", "new buffer is empty");
+  INT_EQ(runner, (int)cmark_html_buffer_len(buffer), 0,
+         "new buffer has no length");
+
+  cmark_render_html_to_buffer(buffer, doc, CMARK_OPT_DEFAULT, NULL);
+  STR_EQ(runner, cmark_html_buffer_data(buffer), html,
+         "buffer output matches cmark_render_html");
+  INT_EQ(runner, (int)cmark_html_buffer_len(buffer), (int)strlen(html),
+         "buffer length matches cmark_render_html");
+  cmark_node_free(doc);
+
+  doc = cmark_parse_document("*x*\n", 4, CMARK_OPT_DEFAULT);
+  cmark_render_html_to_buffer(buffer, doc, CMARK_OPT_DEFAULT, NULL);
+  STR_EQ(runner, cmark_html_buffer_data(buffer), "<p><em>x</em></p>\n",
+         "rendering replaces the buffer contents");
+  INT_EQ(runner, (int)cmark_html_buffer_len(buffer), 18,
+         "rendering replaces the buffer length");
+  cmark_node_free(doc);
+
+  cmark_html_buffer_reset(buffer);
+  STR_EQ(runner, cmark_html_buffer_data(buffer), "", "reset empties buffer");
+  INT_EQ(runner, (int)cmark_html_buffer_len(buffer), 0,
+         "reset buffer has no length");
+
+  free(html);
+  cmark_html_buffer_free(buffer);
+  cmark_html_buffer_free(NULL);
+}
+
+typedef char *(*render_func)(cmark_node *root, int options, int width);
+typedef int (*render_writer_func)(cmark_node *root, int options, int width,
+                                  cmark_write_func write, void *user_data);
+
+static void render_writers(test_batch_runner *runner) {
+  static const struct {
+    const char *name;
+    render_func render;
+    render_writer_func to_writer;
+  } renderers[] = {
+      {"commonmark", cmark_render_commonmark,
+       cmark_render_commonmark_to_writer},
+      {"plaintext", cmark_render_plaintext, cmark_render_plaintext_to_writer},
+      {"latex", cmark_render_latex, cmark_render_latex_to_writer},
+      {"man", cmark_render_man, cmark_render_man_to_writer},
+  };
+  static const int widths[] = {0, 30};
+  cmark_mem *mem = cmark_get_default_mem_allocator();
+  cmark_strbuf md;
+  html_sink sink;
+  cmark_node *doc;
+  char *expected;
+  size_t r, w;
+  int i;
+
+  cmark_strbuf_init(mem, &md, 0);
+  cmark_strbuf_init(mem, &sink.out, 0);
+  sink.fail_after = 0;
+
+  // Long wrapped paragraphs made of many inlines, so that output is
+  // passed on while a line can still be broken, and some nested blocks.
+  for (i = 0; i < 400; i++) {
+    cmark_strbuf_puts(&md, "> - item *with emphasis* and `code` and some "
+                           "more words to wrap 1.\n");
+    if (i % 50 == 49)
+      cmark_strbuf_puts(&md, "\n");
+  }
+  for (i = 0; i < 2000; i++)
+    cmark_strbuf_puts(&md, "word *em* ");
+  cmark_strbuf_puts(&md, "\n");
+  doc = cmark_parse_document((const char *)md.ptr, (size_t)md.size,
+                             CMARK_OPT_DEFAULT);
+
+  for (r = 0; r < sizeof(renderers) / sizeof(*renderers); r++) {
+    for (w = 0; w < sizeof(widths) / sizeof(*widths); w++) {
+      expected = renderers[r].render(doc, CMARK_OPT_DEFAULT, widths[w]);
+      cmark_strbuf_clear(&sink.out);
+      sink.calls = 0;
+      INT_EQ(runner,
+             renderers[r].to_writer(doc, CMARK_OPT_DEFAULT, widths[w],
+                                    collect_html, &sink),
+             1, "%s to writer succeeds", renderers[r].name);
+      OK(runner, sink.calls > 1, "%s output comes in pieces",
+         renderers[r].name);
+      OK(runner,
+         (size_t)sink.out.size == strlen(expected) &&
+             memcmp(sink.out.ptr, expected, strlen(expected)) == 0,
+         "%s writer output matches at width %d", renderers[r].name,
+         widths[w]);
+      free(expected);
+    }
+  }
+
+  cmark_strbuf_clear(&sink.out);
+  sink.calls = 0;
+  sink.fail_after = 1;
+  INT_EQ(runner,
+         cmark_render_commonmark_to_writer(doc, CMARK_OPT_DEFAULT, 0,
+                                           collect_html, &sink),
+         0, "commonmark writer error is reported");
+
+  cmark_node_free(doc);
+  cmark_strbuf_free(&sink.out);
+  cmark_strbuf_free(&md);
+}
+
+// Concatenates the segments of 'doc' and checks them against
+// cmark_render_html.  Returns the number of segments.
+static size_t check_html_segments(test_batch_runner *runner, cmark_node *doc,
+                                  int options, cmark_llist *extensions,
+                                  const char *msg) {
+  cmark_mem *mem = cmark_get_default_mem_allocator();
+  cmark_html_segments *segments =
+      cmark_render_html_segments(doc, options, extensions);
+  char *html = cmark_render_html(doc, options, extensions);
+  const cmark_html_segment *items;
+  cmark_strbuf out;
+  size_t count, i;
+
+  cmark_strbuf_init(mem, &out, 0);
+  items = cmark_html_segments_get(segments, &count);
+  for (i = 0; i < count; i++)
+    cmark_strbuf_put(&out, (const unsigned char *)items[i].data,
+                     (bufsize_t)items[i].len);
+  STR_EQ(runner, cmark_strbuf_cstr(&out), html, "%s", msg);
+  INT_EQ(runner, (int)cmark_html_segments_length(segments), (int)strlen(html),
+         "%s: length", msg);
+
+  cmark_strbuf_free(&out);
+  free(html);
+  cmark_html_segments_free(segments);
+  return count;
+}
+
+static void html_segments(test_batch_runner *runner) {
+  static const char markdown[] =
+      "A paragraph long enough to be referenced rather than copied, "
+      "with *emphasis* and a & in it, and `some code that is long enough "
+      "to be referenced as well`.\n"
+      "\n"
+      "```\n"
+      "int main(void) { return 0; } /* a code block long enough to "
+      "reference */\n"
+      "if (a < b && c) return 1;\n"
+      "```\n"
+      "\n"
+      "<div class=\"raw\">\n"
+      "raw HTML that is output as it is when unsafe output is allowed\n"
+      "</div>\n"
+      "\n"
+      "Short.\n";
+  cmark_mem *mem = cmark_get_default_mem_allocator();
+  cmark_node *doc, *code;
+  cmark_llist *extensions = NULL;
+  cmark_html_segments *segments;
+  const cmark_html_segment *items;
+  const char *literal;
+  size_t count, i;
+  bool referenced = false;
+
+  doc = cmark_parse_document(markdown, sizeof(markdown) - 1,
+                             CMARK_OPT_DEFAULT);
+  check_html_segments(runner, doc, CMARK_OPT_DEFAULT, NULL,
+                      "segments match html");
+  check_html_segments(runner, doc, CMARK_OPT_UNSAFE, NULL,
+                      "segments match unsafe html");
+  check_html_segments(runner, doc, CMARK_OPT_UNSAFE | CMARK_OPT_SOURCEPOS,
+                      NULL, "segments match html with sourcepos");
+
+  cmark_gfm_core_extensions_ensure_registered();
+  extensions = cmark_llist_append(mem, extensions,
+                                  cmark_find_syntax_extension("tagfilter"));
+  check_html_segments(runner, doc, CMARK_OPT_UNSAFE, extensions,
+                      "segments match filtered html");
+  cmark_llist_free(mem, extensions);
+
+  // The code block is not copied.
+  code = cmark_node_next(cmark_node_first_child(doc));
+  literal = cmark_node_get_literal(code);
+  segments = cmark_render_html_segments(doc, CMARK_OPT_DEFAULT, NULL);
+  items = cmark_html_segments_get(segments, &count);
+  for (i = 0; i < count; i++)
+    if (items[i].data >= literal && items[i].data < literal + strlen(literal))
+      referenced = true;
+  OK(runner, referenced, "code block is referenced");
+  cmark_html_segments_free(segments);
+  cmark_node_free(doc);
+
+  doc = cmark_parse_document("", 0, CMARK_OPT_DEFAULT);
+  INT_EQ(runner,
+         (int)check_html_segments(runner, doc, CMARK_OPT_DEFAULT, NULL,
+                                  "empty document"),
+         0, "empty document has no segments");
+  cmark_node_free(doc);
+}
+
+static cmark_inline_byte_set mention_chars;
+static cmark_inline_byte_set mention_ends;
+static int mention_end, mention_comma, mention_span_len;
+
+static cmark_node *match_mention(cmark_syntax_extension *self,
+                                 cmark_parser *parser, cmark_node *parent,
+                                 unsigned char character,
+                                 cmark_inline_parser *inline_parser) {
+  int start = cmark_inline_parser_get_offset(inline_parser);
+  cmark_inline_span name;
+  cmark_node *node;
+  char buf[64];
+
+  (void)self;
+  (void)parser;
+  (void)parent;
+  (void)character;
+
+  cmark_inline_parser_advance_offset(inline_parser);
+  if (mention_end < 0) {
+    mention_end = cmark_inline_parser_find_in_set(inline_parser, &mention_ends);
+    mention_comma = cmark_inline_parser_find_byte(inline_parser, ',');
+    mention_span_len = cmark_inline_parser_get_span(inline_parser, -5, 1000).len;
+  }
+  name = cmark_inline_parser_take_while_in_set(inline_parser, &mention_chars);
+  if (!name.len) {
+    cmark_inline_parser_set_offset(inline_parser, start);
+    return NULL;
+  }
+
+  snprintf(buf, sizeof(buf), "[%.*s]", name.len, (const char *)name.data);
+  node = cmark_node_new_with_mem(CMARK_NODE_CODE,
+                                 cmark_get_default_mem_allocator());
+  cmark_node_set_literal(node, buf);
+  return node;
+}
+
+static void inline_spans(test_batch_runner *runner) {
+  static const char markdown[] = "hi @bob_1, and @ alone.\n";
+  cmark_syntax_extension *ext = cmark_syntax_extension_new("mention");
+  cmark_parser *parser = cmark_parser_new(CMARK_OPT_DEFAULT);
+  cmark_node *doc;
+  char *html;
+
+  cmark_inline_byte_set_init(&mention_chars, "abcdefghijklmnopqrstuvwxyz_1");
+  cmark_inline_byte_set_init(&mention_ends, " ,.");
+  mention_end = -1;
+  cmark_syntax_extension_set_special_inline_chars(
+      ext, cmark_llist_append(cmark_get_default_mem_allocator(), NULL,
+                              (void *)'@'));
+  cmark_syntax_extension_set_match_inline_func(ext, match_mention);
+  cmark_parser_attach_syntax_extension(parser, ext);
+
+  cmark_parser_feed(parser, markdown, sizeof(markdown) - 1);
+  doc = cmark_parser_finish(parser);
+  html = cmark_render_html(doc, CMARK_OPT_DEFAULT, NULL);
+  STR_EQ(runner, html, "<p>hi <code>[bob_1]</code>, and @ alone.</p>\n",
+         "take_while_in_set returns the matched span");
+  INT_EQ(runner, mention_end, 9, "find_in_set finds the first byte in set");
+  INT_EQ(runner, mention_comma, 9, "find_byte finds the byte");
+  INT_EQ(runner, mention_span_len, 23, "get_span is clamped to the chunk");
+  free(html);
+
+  cmark_node_free(doc);
+  cmark_parser_free(parser);
+  cmark_syntax_extension_free(cmark_get_default_mem_allocator(), ext);
+}
+
+static unsigned char *scratch_seen[2];
+static int scratch_matches, scratch_zeroed, scratch_aligned;
+
+static cmark_node *match_scratch(cmark_syntax_extension *self,
+                                 cmark_parser *parser, cmark_node *parent,
+                                 unsigned char character,
+                                 cmark_inline_parser *inline_parser) {
+  unsigned char *p = (unsigned char *)cmark_parser_scratch_alloc(parser, 100);
+  int i;
+
+  (void)self;
+  (void)parent;
+  (void)character;
+  (void)inline_parser;
+
+  for (i = 0; i < 100 && !p[i]; ++i)
+    ;
+  scratch_zeroed += i == 100;
+  scratch_aligned += ((size_t)p % sizeof(double)) == 0;
+  memset(p, 0xff, 100);
+  if (scratch_matches < 2)
+    scratch_seen[scratch_matches] = p;
+  scratch_matches++;
+  return NULL;
+}
+
+static void scratch_memory(test_batch_runner *runner) {
+  static const char markdown[] = "a %\n\nb %\n";
+  static const char table[] = "| a | b \\| c |\n| :- | -: |\n| x | y |\n";
+  cmark_syntax_extension *ext = cmark_syntax_extension_new("scratch");
+  cmark_parser *parser = cmark_parser_new(CMARK_OPT_DEFAULT);
+  cmark_node *doc;
+  char *html;
+
+  cmark_syntax_extension_set_special_inline_chars(
+      ext, cmark_llist_append(cmark_get_default_mem_allocator(), NULL,
+                              (void *)'%'));
+  cmark_syntax_extension_set_match_inline_func(ext, match_scratch);
+  cmark_parser_attach_syntax_extension(parser, ext);
+
+  cmark_parser_feed(parser, markdown, sizeof(markdown) - 1);
+  doc = cmark_parser_finish(parser);
+  INT_EQ(runner, scratch_matches, 2, "scratch extension matched twice");
+  INT_EQ(runner, scratch_zeroed, 2, "scratch memory is zeroed");
+  INT_EQ(runner, scratch_aligned, 2, "scratch memory is aligned");
+  OK(runner, scratch_seen[0] == scratch_seen[1],
+     "scratch memory is reused by the next block");
+  cmark_node_free(doc);
+  cmark_parser_free(parser);
+  cmark_syntax_extension_free(cmark_get_default_mem_allocator(), ext);
+
+  // Table rows are built in scratch memory, even when the document itself
+  // is allocated from the arena.
+  cmark_gfm_core_extensions_ensure_registered();
+  parser = cmark_parser_new_with_mem(CMARK_OPT_DEFAULT,
+                                     cmark_get_arena_mem_allocator());
+  cmark_parser_attach_syntax_extension(parser,
+                                       cmark_find_syntax_extension("table"));
+  cmark_parser_feed(parser, table, sizeof(table) - 1);
+  doc = cmark_parser_finish(parser);
+  html = cmark_render_html_with_mem(doc, CMARK_OPT_DEFAULT, NULL,
+                                    cmark_get_arena_mem_allocator());
+  STR_EQ(runner, html,
+         "<table>\n<thead>\n<tr>\n"
+         "<th align=\"left\">a</th>\n<th align=\"right\">b | c</th>\n"
+         "</tr>\n</thead>\n<tbody>\n<tr>\n"
+         "<td align=\"left\">x</td>\n<td align=\"right\">y</td>\n"
+         "</tr>\n</tbody>\n</table>\n",
+         "table parsed with the arena allocator");
+  cmark_parser_free(parser);
+  cmark_arena_reset();
+}
+
+static void table_autocomplete_limit(test_batch_runner *runner) {
+  static const char markdown[] = "| a | b | c |\n| - | - | - |\n"
+                                 "| x |\n| y |\n| z |\n";
+  static const char limited[] =
+      "<table>\n<thead>\n<tr>\n<th>a</th>\n<th>b</th>\n<th>c</th>\n"
+      "</tr>\n</thead>\n<tbody>\n"
+      "<tr>\n<td>x</td>\n<td></td>\n<td></td>\n</tr>\n"
+      "<tr>\n<td>y</td>\n<td></td>\n<td></td>\n</tr>\n"
+      "</tbody>\n</table>\n<p>| z |</p>\n";
+  cmark_syntax_extension *table;
+  cmark_parser *parser, *other;
+  cmark_node *doc;
+  char *html;
+
+  cmark_gfm_core_extensions_ensure_registered();
+  table = cmark_find_syntax_extension("table");
+  parser = cmark_parser_new(CMARK_OPT_DEFAULT);
+  other = cmark_parser_new(CMARK_OPT_DEFAULT);
+  cmark_parser_attach_syntax_extension(parser, table);
+  cmark_parser_attach_syntax_extension(other, table);
+  INT_EQ(runner, cmark_gfm_extensions_get_table_max_autocompleted_cells(parser),
+         0x80000, "default autocompleted cell limit");
+  INT_EQ(runner,
+         cmark_gfm_extensions_set_table_max_autocompleted_cells(parser, -1), 0,
+         "negative autocompleted cell limit is rejected");
+  INT_EQ(runner,
+         cmark_gfm_extensions_set_table_max_autocompleted_cells(parser, 2), 1,
+         "set autocompleted cell limit");
+  INT_EQ(runner, cmark_gfm_extensions_get_table_max_autocompleted_cells(parser),
+         2, "get autocompleted cell limit");
+  INT_EQ(runner, cmark_gfm_extensions_get_table_max_autocompleted_cells(other),
+         0x80000, "autocompleted cell limit is per parser");
+
+  // Each row autocompletes two cells, so the third row ends the table.
+  cmark_parser_feed(parser, markdown, sizeof(markdown) - 1);
+  doc = cmark_parser_finish(parser);
+  html = cmark_render_html(doc, CMARK_OPT_DEFAULT, NULL);
+  STR_EQ(runner, html, limited,
+         "table ends once it autocompleted too many cells");
+  free(html);
+  cmark_node_free(doc);
+
+  // The limit survives the parser reset in cmark_parser_finish.
+  cmark_parser_feed(parser, markdown, sizeof(markdown) - 1);
+  doc = cmark_parser_finish(parser);
+  html = cmark_render_html(doc, CMARK_OPT_DEFAULT, NULL);
+  STR_EQ(runner, html, limited, "autocompleted cell limit is persistent");
+  free(html);
+  cmark_node_free(doc);
+
+  cmark_parser_feed(other, markdown, sizeof(markdown) - 1);
+  doc = cmark_parser_finish(other);
+  html = cmark_render_html(doc, CMARK_OPT_DEFAULT, NULL);
+  OK(runner, strstr(html, "<td>z</td>") != NULL,
+     "other parsers keep the default limit");
+  free(html);
+  cmark_node_free(doc);
+
+  cmark_parser_free(parser);
+  cmark_parser_free(other);
+}
+
+static char postprocess_log[256];
+
+static void log_event(const char *what, cmark_event_type ev_type) {
+  strcat(postprocess_log, ev_type == CMARK_EVENT_ENTER ? "+" : "-");
+  strcat(postprocess_log, what);
+}
+
+static cmark_node *shout_text(cmark_syntax_extension *ext, cmark_parser *parser,
+                              cmark_node *node, cmark_event_type ev_type) {
+  char buf[64];
+  size_t i;
+
+  (void)ext;
+  (void)parser;
+  log_event("t", ev_type);
+  strncpy(buf, cmark_node_get_literal(node), sizeof(buf) - 1);
+  buf[sizeof(buf) - 1] = 0;
+  for (i = 0; buf[i]; ++i)
+    if (buf[i] >= 'a' && buf[i] <= 'z')
+      buf[i] -= 'a' - 'A';
+  cmark_node_set_literal(node, buf);
+  return node;
+}
+
+static cmark_node *keep_node(cmark_syntax_extension *ext,
+                             cmark_parser *parser, cmark_node *node,
+                             cmark_event_type ev_type) {
+  (void)ext;
+  (void)parser;
+  (void)node;
+  (void)ev_type;
+  return NULL;
+}
+
+static cmark_node *append_paragraph(cmark_syntax_extension *ext,
+                                    cmark_parser *parser, cmark_node *root) {
+  cmark_node *para = cmark_node_new(CMARK_NODE_PARAGRAPH);
+  cmark_node *text = cmark_node_new(CMARK_NODE_TEXT);
+
+  (void)ext;
+  (void)parser;
+  strcat(postprocess_log, "|");
+  cmark_node_set_literal(text, "tail");
+  cmark_node_append_child(para, text);
+  cmark_node_append_child(root, para);
+  return NULL;
+}
+
+static cmark_node *flatten_heading(cmark_syntax_extension *ext,
+                                   cmark_parser *parser, cmark_node *node,
+                                   cmark_event_type ev_type) {
+  cmark_node *para;
+
+  (void)ext;
+  (void)parser;
+  log_event(cmark_node_get_type(node) == CMARK_NODE_HEADING ? "h" : "p",
+            ev_type);
+  if (cmark_node_get_type(node) != CMARK_NODE_HEADING ||
+      ev_type != CMARK_EVENT_EXIT)
+    return node;
+
+  para = cmark_node_new(CMARK_NODE_PARAGRAPH);
+  while (cmark_node_first_child(node))
+    cmark_node_append_child(para, cmark_node_first_child(node));
+  cmark_node_replace(node, para);
+  cmark_node_free(node);
+  return para;
+}
+
+static void postprocess_node_hooks(test_batch_runner *runner) {
+  static const char markdown[] = "# one\n\ntwo *three*\n";
+  cmark_node_type text_types[] = {CMARK_NODE_TEXT, CMARK_NODE_NONE};
+  cmark_node_type block_types[] = {CMARK_NODE_HEADING, CMARK_NODE_PARAGRAPH,
+                                   CMARK_NODE_NONE};
+  cmark_syntax_extension *shout = cmark_syntax_extension_new("shout");
+  cmark_syntax_extension *keep = cmark_syntax_extension_new("keep");
+  cmark_syntax_extension *tail = cmark_syntax_extension_new("tail");
+  cmark_syntax_extension *flatten = cmark_syntax_extension_new("flatten");
+  cmark_mem *mem = cmark_get_default_mem_allocator();
+  cmark_parser *parser;
+  cmark_node *doc;
+  char *html;
+
+  cmark_syntax_extension_set_postprocess_node_func(shout, shout_text);
+  cmark_syntax_extension_set_postprocess_node_types(shout, text_types);
+  cmark_syntax_extension_set_postprocess_node_func(keep, keep_node);
+  cmark_syntax_extension_set_postprocess_func(tail, append_paragraph);
+  cmark_syntax_extension_set_postprocess_node_func(flatten, flatten_heading);
+  cmark_syntax_extension_set_postprocess_node_types(flatten, block_types);
+
+  postprocess_log[0] = 0;
+  parser = cmark_parser_new(CMARK_OPT_DEFAULT);
+  cmark_parser_attach_syntax_extension(parser, shout);
+  cmark_parser_attach_syntax_extension(parser, keep);
+  cmark_parser_attach_syntax_extension(parser, tail);
+  cmark_parser_attach_syntax_extension(parser, flatten);
+  cmark_parser_feed(parser, markdown, sizeof(markdown) - 1);
+  doc = cmark_parser_finish(parser);
+  STR_EQ(runner, postprocess_log, "+t+t+t|+h-h+p-p+p-p",
+         "node hooks run in attachment order around whole-tree hooks");
+  html = cmark_render_html(doc, CMARK_OPT_DEFAULT, NULL);
+  STR_EQ(runner, html, "<p>ONE</p>\n<p>TWO <em>THREE</em></p>\n<p>tail</p>\n",
+         "node hooks can replace the node they are called for, or return "
+         "NULL to keep it");
+  free(html);
+  cmark_node_free(doc);
+  cmark_parser_free(parser);
+
+  cmark_syntax_extension_free(mem, shout);
+  cmark_syntax_extension_free(mem, keep);
+  cmark_syntax_extension_free(mem, tail);
+  cmark_syntax_extension_free(mem, flatten);
+}
+
+static void footnotes_reused_parser(test_batch_runner *runner) {
+  static const char first[] = "a[^x] [^y[^x]]\n\n[^x]: one\n";
+  static const char second[] = "b[^x]\n\n[^y]: two\n";
+  cmark_parser *parser = cmark_parser_new(CMARK_OPT_FOOTNOTES);
+  cmark_node *doc;
+  char *html;
+
+  cmark_parser_feed(parser, first, sizeof(first) - 1);
+  doc = cmark_parser_finish(parser);
+  html = cmark_render_html(doc, CMARK_OPT_FOOTNOTES, NULL);
+  STR_EQ(runner, html,
+         "<p>a<sup class=\"footnote-ref\"><a href=\"#fn-x\" id=\"fnref-x\" "
+         "data-footnote-ref>1</a></sup> [^y[^x]]</p>\n"
+         "<section class=\"footnotes\" data-footnotes>\n<ol>\n"
+         "<li id=\"fn-x\">\n<p>one <a href=\"#fnref-x\" "
+         "class=\"footnote-backref\" data-footnote-backref "
+         "data-footnote-backref-idx=\"1\" aria-label=\"Back to reference "
+         "1\">\xe2\x86\xa9</a></p>\n</li>\n</ol>\n</section>\n",
+         "footnotes resolved");
+  free(html);
+  cmark_node_free(doc);
+
+  cmark_parser_feed(parser, second, sizeof(second) - 1);
+  doc = cmark_parser_finish(parser);
+  html = cmark_render_html(doc, CMARK_OPT_FOOTNOTES, NULL);
+  STR_EQ(runner, html, "<p>b[^x]</p>\n",
+         "footnotes of a previous document are not reused");
+  free(html);
+  cmark_node_free(doc);
+
+  cmark_parser_free(parser);
+}
+
+static int filter_blink(cmark_syntax_extension *ext, const unsigned char *tag,
+                        size_t tag_len) {
+  (void)ext;
+  return !(tag_len >= 6 && strncmp((const char *)tag, "<blink", 6) == 0);
+}
+
+static void html_filter_tags(test_batch_runner *runner) {
+  static const char markdown[] = "<div>\n<Marquee>x</marquee> <x-frame/>\n"
+                                 "<blink> <marqueee>\n</div>\n\n"
+                                 "a <MARQUEE\tid=\"m\"> <blink> <x-frame >\n";
+  static const char *tags[] = {"marquee", "X-Frame", NULL};
+  static const char *invalid_tags[] = {"ok", "not ok", NULL};
+  cmark_syntax_extension *tag_ext = cmark_syntax_extension_new("tags");
+  cmark_syntax_extension *func_ext = cmark_syntax_extension_new("func");
+  cmark_llist *extensions = NULL;
+  cmark_mem *mem = cmark_get_default_mem_allocator();
+  cmark_node *doc;
+  char *html;
+
+  INT_EQ(runner, cmark_syntax_extension_set_html_filter_tags(tag_ext, tags), 1,
+         "set filter tags");
+  INT_EQ(runner,
+         cmark_syntax_extension_set_html_filter_tags(tag_ext, invalid_tags), 0,
+         "invalid filter tags are rejected");
+  cmark_syntax_extension_set_html_filter_func(func_ext, filter_blink);
+  extensions = cmark_llist_append(mem, extensions, tag_ext);
+  extensions = cmark_llist_append(mem, extensions, func_ext);
+
+  doc = cmark_parse_document(markdown, sizeof(markdown) - 1,
+                             CMARK_OPT_DEFAULT);
+  html = cmark_render_html(doc, CMARK_OPT_UNSAFE, extensions);
+  STR_EQ(runner, html,
+         "<div>\n&lt;Marquee>x&lt;/marquee> &lt;x-frame/>\n"
+         "&lt;blink> <marqueee>\n</div>\n"
+         "<p>a &lt;MARQUEE\tid=\"m\"> &lt;blink> &lt;x-frame ></p>\n",
+         "registered tags and filter funcs both apply");
+  free(html);
+
+  INT_EQ(runner, cmark_syntax_extension_set_html_filter_tags(tag_ext, NULL), 1,
+         "clear filter tags");
+  html = cmark_render_html(doc, CMARK_OPT_UNSAFE, extensions);
+  STR_EQ(runner, html,
+         "<div>\n<Marquee>x</marquee> <x-frame/>\n"
+         "&lt;blink> <marqueee>\n</div>\n"
+         "<p>a <MARQUEE\tid=\"m\"> &lt;blink> <x-frame ></p>\n",
+         "cleared tags are no longer filtered");
+  free(html);
+  cmark_node_free(doc);
+
+  cmark_llist_free(mem, extensions);
+  cmark_syntax_extension_free(mem, tag_ext);
+  cmark_syntax_extension_free(mem, func_ext);
+}
+
 int main() {
   int retval;
   test_batch_runner *runner = test_batch_runner_new();
@@ -1139,6 +2169,7 @@ int main() {
   accessors(runner);
   node_check(runner);
   iterator(runner);
+  iterator_init(runner);
   iterator_delete(runner);
   create_tree(runner);
   custom_nodes(runner);
@@ -1152,14 +2183,30 @@ int main() {
   render_plaintext(runner);
   utf8(runner);
   line_endings(runner);
+  html_block_lines(runner);
+  leaf_line_runs(runner);
   numeric_entities(runner);
+  escape_scan_impls(runner);
   test_cplusplus(runner);
   test_safe(runner);
   test_feed_across_line_ending(runner);
   test_pathological_regressions(runner);
   source_pos(runner);
   source_pos_inlines(runner);
+  text_runs(runner);
+  literal_flags(runner);
   ref_source_pos(runner);
+  excerpt(runner);
+  html_writer(runner);
+  html_buffer(runner);
+  render_writers(runner);
+  html_segments(runner);
+  inline_spans(runner);
+  scratch_memory(runner);
+  table_autocomplete_limit(runner);
+  html_filter_tags(runner);
+  footnotes_reused_parser(runner);
+  postprocess_node_hooks(runner);
 
   test_print_summary(runner);
   retval = test_ok(runner) ? 0 : 1;
@@ -0,0 +1,142 @@
+// Microbenchmark for the inline extension scanning helpers.
+//
+// Registers a "mention" extension triggered on '@' that reads the user
+// name following it with one of the helpers, and times parsing a single
+// paragraph made of many mentions.  The extension never produces a node,
+// so the modes differ only in how the name is scanned:
+//
+//   copy  cmark_inline_parser_take_while (malloc'd copy)
+//   span  cmark_inline_parser_take_while_span
+//   set   cmark_inline_parser_take_while_in_set
+//   find  cmark_inline_parser_find_in_set on the bytes ending a name
+//
+// Usage: extension_bench [copy|span|set|find] [mentions] [iterations]
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cmark-gfm.h"
+#include "cmark-gfm-extension_api.h"
+
+typedef enum { MODE_COPY, MODE_SPAN, MODE_SET, MODE_FIND } scan_mode;
+
+static scan_mode mode;
+static cmark_inline_byte_set name_chars;
+static cmark_inline_byte_set name_ends;
+static size_t scanned;
+
+static int is_name_char(int c) { return isalnum(c) || c == '_' || c == '-'; }
+
+static cmark_node *match(cmark_syntax_extension *self, cmark_parser *parser,
+                         cmark_node *parent, unsigned char character,
+                         cmark_inline_parser *inline_parser) {
+  int start = cmark_inline_parser_get_offset(inline_parser);
+  char *copy;
+
+  (void)self;
+  (void)parser;
+  (void)parent;
+  (void)character;
+
+  cmark_inline_parser_advance_offset(inline_parser);
+
+  switch (mode) {
+  case MODE_COPY:
+    copy = cmark_inline_parser_take_while(inline_parser, is_name_char);
+    scanned += strlen(copy);
+    free(copy);
+    break;
+  case MODE_SPAN:
+    scanned += cmark_inline_parser_take_while_span(inline_parser, is_name_char)
+                   .len;
+    break;
+  case MODE_SET:
+    scanned += cmark_inline_parser_take_while_in_set(inline_parser, &name_chars)
+                   .len;
+    break;
+  case MODE_FIND:
+    scanned += cmark_inline_parser_find_in_set(inline_parser, &name_ends) -
+               cmark_inline_parser_get_offset(inline_parser);
+    break;
+  }
+
+  cmark_inline_parser_set_offset(inline_parser, start);
+  return NULL;
+}
+
+static cmark_syntax_extension *create_mention_extension(void) {
+  cmark_syntax_extension *ext = cmark_syntax_extension_new("mention");
+  cmark_llist *special_chars = NULL;
+
+  special_chars =
+      cmark_llist_append(cmark_get_default_mem_allocator(), special_chars, (void *)'@');
+  cmark_syntax_extension_set_special_inline_chars(ext, special_chars);
+  cmark_syntax_extension_set_match_inline_func(ext, match);
+  return ext;
+}
+
+int main(int argc, char *argv[]) {
+  const char *mode_name = argc > 1 ? argv[1] : "span";
+  int mentions = argc > 2 ? atoi(argv[2]) : 10000;
+  int iterations = argc > 3 ? atoi(argv[3]) : 20;
+  cmark_syntax_extension *ext;
+  char *doc, *p;
+  clock_t start, elapsed;
+  int i;
+
+  if (strcmp(mode_name, "copy") == 0) {
+    mode = MODE_COPY;
+  } else if (strcmp(mode_name, "span") == 0) {
+    mode = MODE_SPAN;
+  } else if (strcmp(mode_name, "set") == 0) {
+    mode = MODE_SET;
+  } else if (strcmp(mode_name, "find") == 0) {
+    mode = MODE_FIND;
+  } else {
+    fprintf(stderr, "Usage: %s [copy|span|set|find] [mentions] [iterations]\n",
+            argv[0]);
+    return 1;
+  }
+  if (mentions < 1 || iterations < 1) {
+    fprintf(stderr, "mentions and iterations must be positive\n");
+    return 1;
+  }
+
+  cmark_inline_byte_set_init(&name_chars, "abcdefghijklmnopqrstuvwxyz"
+                                          "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                          "0123456789_-");
+  cmark_inline_byte_set_init(&name_ends, " \t\r\n.,;:!?()[]<>");
+
+  // "@user12345 " per mention, all in one paragraph
+  doc = (char *)malloc((size_t)mentions * 11 + 2);
+  for (p = doc, i = 0; i < mentions; ++i, p += 11)
+    sprintf(p, "@user%05d ", i % 100000);
+  strcpy(p, "\n");
+
+  ext = create_mention_extension();
+
+  start = clock();
+  for (i = 0; i < iterations; ++i) {
+    cmark_parser *parser = cmark_parser_new(CMARK_OPT_DEFAULT);
+    cmark_node *root;
+
+    cmark_parser_attach_syntax_extension(parser, ext);
+    cmark_parser_feed(parser, doc, strlen(doc));
+    root = cmark_parser_finish(parser);
+    cmark_node_free(root);
+    cmark_parser_free(parser);
+  }
+  elapsed = clock() - start;
+
+  printf("%-4s %8d mentions: %8.1f ns/mention (%zu bytes scanned)\n",
+         mode_name, mentions,
+         (double)elapsed / CLOCKS_PER_SEC * 1e9 / ((double)mentions * iterations),
+         scanned);
+
+  cmark_syntax_extension_free(cmark_get_default_mem_allocator(), ext);
+  free(doc);
+  return 0;
+}
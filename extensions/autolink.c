@@ -459,37 +459,31 @@ found_at:
   cmark_chunk_free(parser->mem, &detached_chunk);
 }
 
-static cmark_node *postprocess(cmark_syntax_extension *ext, cmark_parser *parser, cmark_node *root) {
-  cmark_iter *iter;
-  cmark_event_type ev;
-  cmark_node *node;
-  bool in_link = false;
-
-  cmark_consolidate_text_nodes(root);
-  iter = cmark_iter_new(root);
-
-  while ((ev = cmark_iter_next(iter)) != CMARK_EVENT_DONE) {
-    node = cmark_iter_get_node(iter);
-    if (in_link) {
-      if (ev == CMARK_EVENT_EXIT && node->type == CMARK_NODE_LINK) {
-        in_link = false;
-      }
-      continue;
-    }
-
-    if (ev == CMARK_EVENT_ENTER && node->type == CMARK_NODE_LINK) {
-      in_link = true;
-      continue;
-    }
-
-    if (ev == CMARK_EVENT_ENTER && node->type == CMARK_NODE_TEXT) {
+// Links emails in the text below 'parent' as soon as its inlines are
+// parsed, skipping the text of links.  Nodes are visited in the same order
+// as by a cmark_iter, including the ones postprocess_text inserts.
+static void postprocess_inlines(cmark_syntax_extension *ext,
+                                cmark_parser *parser, cmark_node *parent) {
+  cmark_node *node = parent->first_child;
+
+  // An '@' in the text comes from the source as is, or from an entity.
+  if (!memchr(parent->content.ptr, '@', parent->content.size) &&
+      !memchr(parent->content.ptr, '&', parent->content.size))
+    return;
+
+  while (node) {
+    if (node->type == CMARK_NODE_TEXT &&
+        memchr(node->as.literal.data, '@', node->as.literal.len))
       postprocess_text(parser, node);
+
+    if (node->type != CMARK_NODE_LINK && node->first_child) {
+      node = node->first_child;
+    } else {
+      while (node != parent && !node->next)
+        node = node->parent;
+      node = node == parent ? NULL : node->next;
     }
   }
-
-  cmark_iter_free(iter);
-
-  return root;
 }
 
 cmark_syntax_extension *create_autolink_extension(void) {
@@ -497,7 +491,7 @@ cmark_syntax_extension *create_autolink_extension(void) {
   cmark_llist *special_chars = NULL;
 
   cmark_syntax_extension_set_match_inline_func(ext, match);
-  cmark_syntax_extension_set_postprocess_func(ext, postprocess);
+  cmark_syntax_extension_set_postprocess_inlines_func(ext, postprocess_inlines);
 
   cmark_mem *mem = cmark_get_default_mem_allocator();
   special_chars = cmark_llist_append(mem, special_chars, (void *)':');
@@ -37,6 +37,24 @@ int cmark_gfm_extensions_get_table_row_is_header(cmark_node *node);
 CMARK_GFM_EXPORT
 int cmark_gfm_extensions_set_table_row_is_header(cmark_node *node, int is_header);
 
+/** Returns the maximum number of cells a table parsed by 'parser' may
+ * autocomplete for rows shorter than its header.
+ */
+CMARK_GFM_EXPORT
+int cmark_gfm_extensions_get_table_max_autocompleted_cells(cmark_parser *parser);
+
+/** Sets the maximum number of cells a table parsed by 'parser' may
+ * autocomplete for rows shorter than its header, returning 1 on success
+ * and 0 on error.  Once a table has autocompleted more cells than this, it
+ * ends, and the following lines are parsed as if it weren't there.  This
+ * bounds the size of the tree by a constant times the size of the input.
+ * Defaults to 524288.  The limit persists across calls to
+ * 'cmark_parser_finish'.
+ */
+CMARK_GFM_EXPORT
+int cmark_gfm_extensions_set_table_max_autocompleted_cells(cmark_parser *parser,
+                                                           int max_cells);
+
 CMARK_GFM_EXPORT
 bool cmark_gfm_extensions_get_tasklist_item_checked(cmark_node *node);
 /* For backwards compatibility */
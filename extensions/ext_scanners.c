@@ -219,361 +219,6 @@ bufsize_t _scan_table_start(const unsigned char *p) {
   }
 }
 
-bufsize_t _scan_table_cell(const unsigned char *p) {
-  const unsigned char *marker = NULL;
-  const unsigned char *start = p;
-
-  {
-    unsigned char yych;
-    unsigned int yyaccept = 0;
-    static const unsigned char yybm[] = {
-        64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 0,  64, 64, 0,  64, 64, 64, 64,
-        64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 128, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 0,  64,
-        64, 64, 0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,   0,
-    };
-    yych = *p;
-    if (yybm[0 + yych] & 64) {
-      goto yy22;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\r')
-          goto yy25;
-        if (yych <= '\\')
-          goto yy27;
-        goto yy25;
-      } else {
-        if (yych <= 0xDF)
-          goto yy29;
-        if (yych <= 0xE0)
-          goto yy30;
-        goto yy31;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy32;
-        if (yych <= 0xEF)
-          goto yy31;
-        goto yy33;
-      } else {
-        if (yych <= 0xF3)
-          goto yy34;
-        if (yych <= 0xF4)
-          goto yy35;
-        goto yy25;
-      }
-    }
-  yy22:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yybm[0 + yych] & 64) {
-      goto yy22;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\r')
-          goto yy24;
-        if (yych <= '\\')
-          goto yy27;
-      } else {
-        if (yych <= 0xDF)
-          goto yy36;
-        if (yych <= 0xE0)
-          goto yy38;
-        goto yy39;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy40;
-        if (yych <= 0xEF)
-          goto yy39;
-        goto yy41;
-      } else {
-        if (yych <= 0xF3)
-          goto yy42;
-        if (yych <= 0xF4)
-          goto yy43;
-      }
-    }
-  yy24 : { return (bufsize_t)(p - start); }
-  yy25:
-    ++p;
-  yy26 : { return 0; }
-  yy27:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yybm[0 + yych] & 128) {
-      goto yy27;
-    }
-    if (yych <= 0xDF) {
-      if (yych <= '\f') {
-        if (yych == '\n')
-          goto yy24;
-        goto yy22;
-      } else {
-        if (yych <= '\r')
-          goto yy24;
-        if (yych <= 0x7F)
-          goto yy22;
-        if (yych <= 0xC1)
-          goto yy24;
-        goto yy36;
-      }
-    } else {
-      if (yych <= 0xEF) {
-        if (yych <= 0xE0)
-          goto yy38;
-        if (yych == 0xED)
-          goto yy40;
-        goto yy39;
-      } else {
-        if (yych <= 0xF0)
-          goto yy41;
-        if (yych <= 0xF3)
-          goto yy42;
-        if (yych <= 0xF4)
-          goto yy43;
-        goto yy24;
-      }
-    }
-  yy29:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy26;
-    if (yych <= 0xBF)
-      goto yy22;
-    goto yy26;
-  yy30:
-    yyaccept = 1;
-    yych = *(marker = ++p);
-    if (yych <= 0x9F)
-      goto yy26;
-    if (yych <= 0xBF)
-      goto yy36;
-    goto yy26;
-  yy31:
-    yyaccept = 1;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy26;
-    if (yych <= 0xBF)
-      goto yy36;
-    goto yy26;
-  yy32:
-    yyaccept = 1;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy26;
-    if (yych <= 0x9F)
-      goto yy36;
-    goto yy26;
-  yy33:
-    yyaccept = 1;
-    yych = *(marker = ++p);
-    if (yych <= 0x8F)
-      goto yy26;
-    if (yych <= 0xBF)
-      goto yy39;
-    goto yy26;
-  yy34:
-    yyaccept = 1;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy26;
-    if (yych <= 0xBF)
-      goto yy39;
-    goto yy26;
-  yy35:
-    yyaccept = 1;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy26;
-    if (yych <= 0x8F)
-      goto yy39;
-    goto yy26;
-  yy36:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy37;
-    if (yych <= 0xBF)
-      goto yy22;
-  yy37:
-    p = marker;
-    if (yyaccept == 0) {
-      goto yy24;
-    } else {
-      goto yy26;
-    }
-  yy38:
-    yych = *++p;
-    if (yych <= 0x9F)
-      goto yy37;
-    if (yych <= 0xBF)
-      goto yy36;
-    goto yy37;
-  yy39:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy37;
-    if (yych <= 0xBF)
-      goto yy36;
-    goto yy37;
-  yy40:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy37;
-    if (yych <= 0x9F)
-      goto yy36;
-    goto yy37;
-  yy41:
-    yych = *++p;
-    if (yych <= 0x8F)
-      goto yy37;
-    if (yych <= 0xBF)
-      goto yy39;
-    goto yy37;
-  yy42:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy37;
-    if (yych <= 0xBF)
-      goto yy39;
-    goto yy37;
-  yy43:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy37;
-    if (yych <= 0x8F)
-      goto yy39;
-    goto yy37;
-  }
-}
-
-bufsize_t _scan_table_cell_end(const unsigned char *p) {
-  const unsigned char *start = p;
-
-  {
-    unsigned char yych;
-    static const unsigned char yybm[] = {
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 128, 0, 128, 128, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   128, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0,
-    };
-    yych = *p;
-    if (yych == '|')
-      goto yy48;
-    ++p;
-    { return 0; }
-  yy48:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy48;
-    }
-    { return (bufsize_t)(p - start); }
-  }
-}
-
-bufsize_t _scan_table_row_end(const unsigned char *p) {
-  const unsigned char *marker = NULL;
-  const unsigned char *start = p;
-
-  {
-    unsigned char yych;
-    static const unsigned char yybm[] = {
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 128, 0, 128, 128, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   128, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,   0, 0,   0,   0, 0, 0,
-    };
-    yych = *p;
-    if (yych <= '\f') {
-      if (yych <= 0x08)
-        goto yy53;
-      if (yych == '\n')
-        goto yy56;
-      goto yy55;
-    } else {
-      if (yych <= '\r')
-        goto yy58;
-      if (yych == ' ')
-        goto yy55;
-    }
-  yy53:
-    ++p;
-  yy54 : { return 0; }
-  yy55:
-    yych = *(marker = ++p);
-    if (yych <= 0x08)
-      goto yy54;
-    if (yych <= '\r')
-      goto yy60;
-    if (yych == ' ')
-      goto yy60;
-    goto yy54;
-  yy56:
-    ++p;
-    { return (bufsize_t)(p - start); }
-  yy58:
-    yych = *++p;
-    if (yych == '\n')
-      goto yy56;
-    goto yy54;
-  yy59:
-    yych = *++p;
-  yy60:
-    if (yybm[0 + yych] & 128) {
-      goto yy59;
-    }
-    if (yych <= 0x08)
-      goto yy61;
-    if (yych <= '\n')
-      goto yy56;
-    if (yych <= '\r')
-      goto yy62;
-  yy61:
-    p = marker;
-    goto yy54;
-  yy62:
-    yych = *++p;
-    if (yych == '\n')
-      goto yy56;
-    goto yy61;
-  }
-}
-
 bufsize_t _scan_tasklist(const unsigned char *p) {
   const unsigned char *marker = NULL;
   const unsigned char *start = p;
@@ -5,13 +5,22 @@
 #include <references.h>
 #include <string.h>
 #include <render.h>
+#include <syntax_extension.h>
+#include <utf8.h>
 
 #include "ext_scanners.h"
 #include "strikethrough.h"
 #include "table.h"
 #include "cmark-gfm-core-extensions.h"
 
-// Limit to prevent a malicious input from causing a denial of service.
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TABLE_SCAN_SSE2 1
+#endif
+
+// Default limit to prevent a malicious input from causing a denial of
+// service, see `cmark_gfm_extensions_set_table_max_autocompleted_cells`.
 #define MAX_AUTOCOMPLETED_CELLS 0x80000
 
 // Custom node flag, initialized in `create_table_extension`.
@@ -20,8 +29,13 @@ static cmark_node_internal_flags CMARK_NODE__TABLE_VISITED;
 cmark_node_type CMARK_NODE_TABLE, CMARK_NODE_TABLE_ROW,
     CMARK_NODE_TABLE_CELL;
 
+// Rows and their cells only live while a line is being parsed, and are
+// allocated from the parser's scratch memory.
 typedef struct {
-  cmark_strbuf *buf;
+  // Trimmed cell text with escaped pipes unescaped: a span of the row
+  // unless the cell holds an escaped pipe, not NUL-terminated
+  const unsigned char *text;
+  bufsize_t len;
   int start_offset, end_offset, internal_offset;
 } node_cell;
 
@@ -35,34 +49,18 @@ typedef struct {
   uint16_t n_columns;
   uint8_t *alignments;
   int n_rows;
-  int n_nonempty_cells;
+  int n_autocompleted_cells;
+  // The row found by 'matches' for the line being parsed, handed over to
+  // try_opening_table_row so that each row is only tokenized once
+  table_row *matched_row;
+  const unsigned char *matched_input;
+  int matched_line;
 } node_table;
 
 typedef struct {
   bool is_header;
 } node_table_row;
 
-static void free_table_cell(cmark_mem *mem, node_cell *cell) {
-  cmark_strbuf_free((cmark_strbuf *)cell->buf);
-  mem->free(cell->buf);
-}
-
-static void free_row_cells(cmark_mem *mem, table_row *row) {
-  while (row->n_columns > 0) {
-    free_table_cell(mem, &row->cells[--row->n_columns]);
-  }
-  mem->free(row->cells);
-  row->cells = NULL;
-}
-
-static void free_table_row(cmark_mem *mem, table_row *row) {
-  if (!row)
-    return;
-
-  free_row_cells(mem, row);
-  mem->free(row);
-}
-
 static void free_node_table(cmark_mem *mem, void *ptr) {
   node_table *t = (node_table *)ptr;
   mem->free(t->alignments);
@@ -88,31 +86,37 @@ static int set_n_table_columns(cmark_node *node, uint16_t n_columns) {
   return 1;
 }
 
-// Increment the number of rows in the table. Also update n_nonempty_cells,
-// which keeps track of the number of cells which were parsed from the
-// input file. (If one of the rows is too short, then the trailing cells
-// are autocompleted. Autocompleted cells are not counted in n_nonempty_cells.)
-// The purpose of this is to prevent a malicious input from generating a very
-// large number of autocompleted cells, which could cause a denial of service
-// vulnerability.
+// Increment the number of rows in the table, 'i' of whose cells were parsed
+// from the input file. If the row is too short, then its trailing cells are
+// autocompleted, and counted in n_autocompleted_cells. The purpose of this
+// is to prevent a malicious input from generating a very large number of
+// autocompleted cells, which could cause a denial of service vulnerability.
+// The count is kept directly, rather than derived from the number of rows,
+// so that it can't overflow however long the table gets.
 static int incr_table_row_count(cmark_node *node, int i) {
   if (!node || node->type != CMARK_NODE_TABLE) {
     return 0;
   }
 
-  ((node_table *)node->as.opaque)->n_rows++;
-  ((node_table *)node->as.opaque)->n_nonempty_cells += i;
+  node_table *nt = (node_table *)node->as.opaque;
+  nt->n_rows++;
+  if (i < nt->n_columns)
+    nt->n_autocompleted_cells += nt->n_columns - i;
   return 1;
 }
 
-// Calculate the number of autocompleted cells.
 static int get_n_autocompleted_cells(cmark_node *node) {
   if (!node || node->type != CMARK_NODE_TABLE) {
     return 0;
   }
 
-  const node_table *nt = (node_table *)node->as.opaque;
-  return (nt->n_columns * nt->n_rows) - nt->n_nonempty_cells;
+  return ((node_table *)node->as.opaque)->n_autocompleted_cells;
+}
+
+static int get_max_autocompleted_cells(cmark_parser *parser) {
+  return parser->table_max_autocompleted_cells < 0
+             ? MAX_AUTOCOMPLETED_CELLS
+             : parser->table_max_autocompleted_cells;
 }
 
 static uint8_t *get_table_alignments(cmark_node *node) {
@@ -147,48 +151,163 @@ static int set_cell_index(cmark_node *node, int i) {
   return 1;
 }
 
-static cmark_strbuf *unescape_pipes(cmark_mem *mem, unsigned char *string, bufsize_t len)
+// Trims the cell or paragraph text in 'string' and unescapes its escaped
+// pipes.  The result is 'string' itself unless there was a pipe to
+// unescape, in which case it's copied to scratch memory.  Trimming first
+// is equivalent, as an escaped pipe holds no whitespace.
+static const unsigned char *unescape_pipes(cmark_parser *parser,
+                                           const unsigned char *string,
+                                           bufsize_t len, bool escaped_pipe,
+                                           bufsize_t *out_len)
 {
-  cmark_strbuf *res = (cmark_strbuf *)mem->calloc(1, sizeof(cmark_strbuf));
+  unsigned char *res;
   bufsize_t r, w;
 
-  cmark_strbuf_init(mem, res, len + 1);
-  cmark_strbuf_put(res, string, len);
-  cmark_strbuf_putc(res, '\0');
+  while (len > 0 && cmark_isspace(string[0])) {
+    ++string;
+    --len;
+  }
+  while (len > 0 && cmark_isspace(string[len - 1]))
+    --len;
+
+  *out_len = len;
+  if (!escaped_pipe)
+    return string;
+
+  res = (unsigned char *)cmark_parser_scratch_alloc(parser, len);
 
   for (r = 0, w = 0; r < len; ++r) {
-    if (res->ptr[r] == '\\' && res->ptr[r + 1] == '|')
+    if (string[r] == '\\' && r + 1 < len && string[r + 1] == '|')
       r++;
 
-    res->ptr[w++] = res->ptr[r];
+    res[w++] = string[r];
   }
 
-  cmark_strbuf_truncate(res, w);
-
+  *out_len = w;
   return res;
 }
 
+static bool is_cell_special(unsigned char c) {
+  return c == '|' || c == '\r' || c == '\n' || c >= 0x80;
+}
+
+// Returns the first byte in [p, end) that may end a cell: a pipe, a line
+// ending, or the start of a non-ASCII sequence, which has to be validated.
+static const unsigned char *find_cell_special(const unsigned char *p,
+                                              const unsigned char *end) {
+#ifdef TABLE_SCAN_SSE2
+  const __m128i pipe = _mm_set1_epi8('|');
+  const __m128i cr = _mm_set1_epi8('\r');
+  const __m128i lf = _mm_set1_epi8('\n');
+
+  // Skip whole blocks of plain bytes; the scalar loop below finds the
+  // special byte in the block that has one.
+  while (end - p >= 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    __m128i hits = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, pipe), _mm_cmpeq_epi8(v, cr)),
+        _mm_or_si128(_mm_cmpeq_epi8(v, lf), v));
+
+    if (_mm_movemask_epi8(hits))
+      break;
+    p += 16;
+  }
+#endif
+
+  while (p < end && !is_cell_special(*p))
+    ++p;
+  return p;
+}
+
+// The length of the cell at 'offset': valid UTF-8 up to the first pipe or
+// line ending, where a pipe preceded by a backslash is part of the cell.
+// Sets 'escaped_pipe' if the cell holds such a pipe.
+static bufsize_t scan_cell(const unsigned char *string, bufsize_t len,
+                           bufsize_t offset, bool *escaped_pipe) {
+  const unsigned char *start = string + offset, *end = string + len;
+  const unsigned char *p = start;
+  int32_t uc;
+  int n;
+
+  *escaped_pipe = false;
+  if (offset >= len)
+    return 0;
+
+  while ((p = find_cell_special(p, end)) < end) {
+    if (*p == '|' && p > start && p[-1] == '\\') {
+      *escaped_pipe = true;
+      ++p;
+    } else if (*p < 0x80) {
+      break;
+    } else if ((n = cmark_utf8proc_iterate(p, (bufsize_t)(end - p), &uc)) > 0) {
+      p += n;
+    } else {
+      break;
+    }
+  }
+
+  return (bufsize_t)(p - start);
+}
+
+static bool is_table_space(unsigned char c) {
+  return c == ' ' || c == '\t' || c == '\v' || c == '\f';
+}
+
+// The length of the pipe at 'offset' and the spaces after it, or 0
+static bufsize_t scan_cell_end(const unsigned char *string, bufsize_t len,
+                               bufsize_t offset) {
+  bufsize_t i = offset;
+
+  if (i >= len || string[i] != '|')
+    return 0;
+  ++i;
+  while (i < len && is_table_space(string[i]))
+    ++i;
+  return i - offset;
+}
+
+// The length of the spaces and line ending at 'offset', or 0
+static bufsize_t scan_row_end(const unsigned char *string, bufsize_t len,
+                              bufsize_t offset) {
+  bufsize_t i = offset;
+
+  while (i < len && is_table_space(string[i]))
+    ++i;
+  if (i < len && string[i] == '\r')
+    ++i;
+  if (i < len && string[i] == '\n')
+    return i + 1 - offset;
+  return 0;
+}
+
 // Adds a new cell to the end of the row. A pointer to the new cell is returned
 // for the caller to initialize.
-static node_cell* append_row_cell(cmark_mem *mem, table_row *row) {
+static node_cell* append_row_cell(cmark_parser *parser, table_row *row) {
   const uint32_t n_columns = row->n_columns + 1;
-  // realloc when n_columns is a power of 2
+  // grow when n_columns is a power of 2
   if ((n_columns & (n_columns-1)) == 0) {
+    node_cell *cells;
+
     // make sure we never wrap row->n_columns
     // offset will != len and our exit will clean up as intended
     if (n_columns > UINT16_MAX) {
       return NULL;
     }
-    // Use realloc to double the size of the buffer.
-    row->cells = (node_cell *)mem->realloc(row->cells, (2 * n_columns - 1) * sizeof(node_cell));
+    // Double the size of the buffer.  Scratch memory can't be resized, so
+    // the old cells are copied and left for the scratch reset to reclaim.
+    cells = (node_cell *)cmark_parser_scratch_alloc(
+        parser, (2 * n_columns - 1) * sizeof(node_cell));
+    if (row->n_columns)
+      memcpy(cells, row->cells, row->n_columns * sizeof(node_cell));
+    row->cells = cells;
   }
   row->n_columns = (uint16_t)n_columns;
   return &row->cells[n_columns-1];
 }
 
 static table_row *row_from_string(cmark_syntax_extension *self,
-                                  cmark_parser *parser, unsigned char *string,
-                                  int len) {
+                                  cmark_parser *parser,
+                                  const unsigned char *string, int len) {
   // Parses a single table row. It has the following form:
   // `delim? table_cell (delim table_cell)* delim? newline`
   // Note that cells are allowed to be empty.
@@ -202,39 +321,33 @@ static table_row *row_from_string(cmark_syntax_extension *self,
 
   table_row *row = NULL;
   bufsize_t cell_matched = 1, pipe_matched = 1, offset;
+  bool escaped_pipe;
   int expect_more_cells = 1;
   int row_end_offset = 0;
   int int_overflow_abort = 0;
 
-  row = (table_row *)parser->mem->calloc(1, sizeof(table_row));
-  row->n_columns = 0;
-  row->cells = NULL;
+  row = (table_row *)cmark_parser_scratch_alloc(parser, sizeof(table_row));
 
   // Scan past the (optional) leading pipe.
-  offset = scan_table_cell_end(string, len, 0);
+  offset = scan_cell_end(string, len, 0);
 
   // Parse the cells of the row. Stop if we reach the end of the input, or if we
   // cannot detect any more cells.
   while (offset < len && expect_more_cells) {
-    cell_matched = scan_table_cell(string, len, offset);
-    pipe_matched = scan_table_cell_end(string, len, offset + cell_matched);
+    cell_matched = scan_cell(string, len, offset, &escaped_pipe);
+    pipe_matched = scan_cell_end(string, len, offset + cell_matched);
 
     if (cell_matched || pipe_matched) {
       // We are guaranteed to have a cell, since (1) either we found some
       // content and cell_matched, or (2) we found an empty cell followed by a
       // pipe.
-      cmark_strbuf *cell_buf = unescape_pipes(parser->mem, string + offset,
-          cell_matched);
-      cmark_strbuf_trim(cell_buf);
-
-      node_cell *cell = append_row_cell(parser->mem, row);
+      node_cell *cell = append_row_cell(parser, row);
       if (!cell) {
         int_overflow_abort = 1;
-        cmark_strbuf_free(cell_buf);
-        parser->mem->free(cell_buf);
         break;
       }
-      cell->buf = cell_buf;
+      cell->text = unescape_pipes(parser, string + offset, cell_matched,
+                                  escaped_pipe, &cell->len);
       cell->start_offset = offset;
       cell->end_offset = offset + cell_matched - 1;
       cell->internal_offset = 0;
@@ -251,7 +364,7 @@ static table_row *row_from_string(cmark_syntax_extension *self,
       expect_more_cells = 1;
     } else {
       // We've scanned the last cell. Check if we have reached the end of the row
-      row_end_offset = scan_table_row_end(string, len, offset);
+      row_end_offset = scan_row_end(string, len, offset);
       offset += row_end_offset;
 
       // If the end of the row is not the end of the input,
@@ -260,10 +373,11 @@ static table_row *row_from_string(cmark_syntax_extension *self,
       if (row_end_offset && offset != len) {
         row->paragraph_offset = offset;
 
-        free_row_cells(parser->mem, row);
+        row->n_columns = 0;
+        row->cells = NULL;
 
         // Scan past the (optional) leading pipe.
-        offset += scan_table_cell_end(string, len, offset);
+        offset += scan_cell_end(string, len, offset);
 
         expect_more_cells = 1;
       } else {
@@ -272,10 +386,8 @@ static table_row *row_from_string(cmark_syntax_extension *self,
     }
   }
 
-  if (offset != len || row->n_columns == 0 || int_overflow_abort) {
-    free_table_row(parser->mem, row);
+  if (offset != len || row->n_columns == 0 || int_overflow_abort)
     row = NULL;
-  }
 
   return row;
 }
@@ -285,15 +397,14 @@ static void try_inserting_table_header_paragraph(cmark_parser *parser,
                                                  unsigned char *parent_string,
                                                  int paragraph_offset) {
   cmark_node *paragraph;
-  cmark_strbuf *paragraph_content;
+  const unsigned char *paragraph_content;
+  bufsize_t paragraph_len;
 
   paragraph = cmark_node_new_with_mem(CMARK_NODE_PARAGRAPH, parser->mem);
 
-  paragraph_content = unescape_pipes(parser->mem, parent_string, paragraph_offset);
-  cmark_strbuf_trim(paragraph_content);
-  cmark_node_set_string_content(paragraph, (char *) paragraph_content->ptr);
-  cmark_strbuf_free(paragraph_content);
-  parser->mem->free(paragraph_content);
+  paragraph_content = unescape_pipes(parser, parent_string, paragraph_offset,
+                                     true, &paragraph_len);
+  cmark_strbuf_set(&paragraph->content, paragraph_content, paragraph_len);
 
   if (!cmark_node_insert_before(parent_container, paragraph)) {
     parser->mem->free(paragraph);
@@ -330,8 +441,6 @@ static cmark_node *try_opening_table_header(cmark_syntax_extension *self,
 
   assert(delimiter_row);
 
-  cmark_arena_push();
-
   // Check for a matching header row. We call `row_from_string` with the entire
   // (potentially long) parent container as input, but this should be safe since
   // `row_from_string` bails out early if it does not find a row.
@@ -339,30 +448,11 @@ static cmark_node *try_opening_table_header(cmark_syntax_extension *self,
   header_row = row_from_string(self, parser, (unsigned char *)parent_string,
                                (int)strlen(parent_string));
   if (!header_row || header_row->n_columns != delimiter_row->n_columns) {
-    free_table_row(parser->mem, delimiter_row);
-    free_table_row(parser->mem, header_row);
-    cmark_arena_pop();
     parent_container->flags |= CMARK_NODE__TABLE_VISITED;
     return parent_container;
   }
 
-  if (cmark_arena_pop()) {
-    delimiter_row = row_from_string(
-        self, parser, input + cmark_parser_get_first_nonspace(parser),
-        len - cmark_parser_get_first_nonspace(parser));
-    header_row = row_from_string(self, parser, (unsigned char *)parent_string,
-                                 (int)strlen(parent_string));
-    // row_from_string can return NULL, add additional check to ensure n_columns match
-    if (!delimiter_row || !header_row || header_row->n_columns != delimiter_row->n_columns) {
-        free_table_row(parser->mem, delimiter_row);
-        free_table_row(parser->mem, header_row);
-        return parent_container;
-    }
-  }
-
   if (!cmark_node_set_type(parent_container, CMARK_NODE_TABLE)) {
-    free_table_row(parser->mem, header_row);
-    free_table_row(parser->mem, delimiter_row);
     return parent_container;
   }
 
@@ -381,7 +471,7 @@ static cmark_node *try_opening_table_header(cmark_syntax_extension *self,
       (uint8_t *)parser->mem->calloc(delimiter_row->n_columns, sizeof(uint8_t));
   for (i = 0; i < delimiter_row->n_columns; ++i) {
     node_cell *node = &delimiter_row->cells[i];
-    bool left = node->buf->ptr[0] == ':', right = node->buf->ptr[node->buf->size - 1] == ':';
+    bool left = node->text[0] == ':', right = node->text[node->len - 1] == ':';
 
     if (left && right)
       alignments[i] = 'c';
@@ -409,7 +499,7 @@ static cmark_node *try_opening_table_header(cmark_syntax_extension *self,
     header_cell->start_line = header_cell->end_line = parent_container->start_line;
     header_cell->internal_offset = cell->internal_offset;
     header_cell->end_column = parent_container->start_column + cell->end_offset;
-    cmark_node_set_string_content(header_cell, (char *) cell->buf->ptr);
+    cmark_strbuf_set(&header_cell->content, cell->text, cell->len);
     cmark_node_set_syntax_extension(header_cell, self);
     set_cell_index(header_cell, i);
   }
@@ -420,8 +510,6 @@ static cmark_node *try_opening_table_header(cmark_syntax_extension *self,
       parser, (char *)input,
       (int)strlen((char *)input) - 1 - cmark_parser_get_offset(parser), false);
 
-  free_table_row(parser->mem, header_row);
-  free_table_row(parser->mem, delimiter_row);
   return parent_container;
 }
 
@@ -429,13 +517,16 @@ static cmark_node *try_opening_table_row(cmark_syntax_extension *self,
                                          cmark_parser *parser,
                                          cmark_node *parent_container,
                                          unsigned char *input, int len) {
+  node_table *nt = (node_table *)parent_container->as.opaque;
+  const unsigned char *row_input = input + cmark_parser_get_first_nonspace(parser);
   cmark_node *table_row_block;
   table_row *row;
 
   if (cmark_parser_is_blank(parser))
     return NULL;
 
-  if (get_n_autocompleted_cells(parent_container) > MAX_AUTOCOMPLETED_CELLS) {
+  if (get_n_autocompleted_cells(parent_container) >
+      get_max_autocompleted_cells(parser)) {
     return NULL;
   }
 
@@ -446,8 +537,13 @@ static cmark_node *try_opening_table_row(cmark_syntax_extension *self,
   table_row_block->end_column = parent_container->end_column;
   table_row_block->as.opaque = parser->mem->calloc(1, sizeof(node_table_row));
 
-  row = row_from_string(self, parser, input + cmark_parser_get_first_nonspace(parser),
-      len - cmark_parser_get_first_nonspace(parser));
+  if (nt->matched_row && nt->matched_input == row_input &&
+      nt->matched_line == cmark_parser_get_line_number(parser))
+    row = nt->matched_row;
+  else
+    row = row_from_string(self, parser, row_input,
+                          len - cmark_parser_get_first_nonspace(parser));
+  nt->matched_row = NULL;
 
   if (!row) {
       // clean up the dangling node
@@ -464,7 +560,7 @@ static cmark_node *try_opening_table_row(cmark_syntax_extension *self,
           CMARK_NODE_TABLE_CELL, parent_container->start_column + cell->start_offset);
       node->internal_offset = cell->internal_offset;
       node->end_column = parent_container->start_column + cell->end_offset;
-      cmark_node_set_string_content(node, (char *) cell->buf->ptr);
+      cmark_strbuf_set(&node->content, cell->text, cell->len);
       cmark_node_set_syntax_extension(node, self);
       set_cell_index(node, i);
     }
@@ -479,8 +575,6 @@ static cmark_node *try_opening_table_row(cmark_syntax_extension *self,
     }
   }
 
-  free_table_row(parser->mem, row);
-
   cmark_parser_advance_offset(parser, (char *)input,
                               len - 1 - cmark_parser_get_offset(parser), false);
 
@@ -508,14 +602,18 @@ static int matches(cmark_syntax_extension *self, cmark_parser *parser,
   int res = 0;
 
   if (cmark_node_get_type(parent_container) == CMARK_NODE_TABLE) {
-    cmark_arena_push();
+    node_table *nt = (node_table *)parent_container->as.opaque;
+    const unsigned char *row_input =
+        input + cmark_parser_get_first_nonspace(parser);
     table_row *new_row = row_from_string(
-        self, parser, input + cmark_parser_get_first_nonspace(parser),
-        len - cmark_parser_get_first_nonspace(parser));
+        self, parser, row_input, len - cmark_parser_get_first_nonspace(parser));
     if (new_row && new_row->n_columns)
       res = 1;
-    free_table_row(parser->mem, new_row);
-    cmark_arena_pop();
+
+    // The row lives in scratch memory until the end of this line
+    nt->matched_row = new_row;
+    nt->matched_input = row_input;
+    nt->matched_line = cmark_parser_get_line_number(parser);
   }
 
   return res;
@@ -656,15 +754,41 @@ static void latex_render(cmark_syntax_extension *extension,
   }
 }
 
+// Cell alignment attributes, indexed by whether style attributes are
+// preferred and by alignment, so that each cell gets its attribute with a
+// single lookup and copy.
+typedef struct {
+  const char *attr;
+  bufsize_t len;
+} table_align_attr;
+
+#define TABLE_ALIGN_ATTR(s) { s, sizeof(s) - 1 }
+
+static const table_align_attr table_align_attrs[2][3] = {
+    {TABLE_ALIGN_ATTR(" align=\"left\""), TABLE_ALIGN_ATTR(" align=\"center\""),
+     TABLE_ALIGN_ATTR(" align=\"right\"")},
+    {TABLE_ALIGN_ATTR(" style=\"text-align: left\""),
+     TABLE_ALIGN_ATTR(" style=\"text-align: center\""),
+     TABLE_ALIGN_ATTR(" style=\"text-align: right\"")}};
+
+static const table_align_attr *get_align_attr(uint8_t alignment,
+                                              int prefer_style) {
+  switch (alignment) {
+  case 'l': return &table_align_attrs[prefer_style][0];
+  case 'c': return &table_align_attrs[prefer_style][1];
+  case 'r': return &table_align_attrs[prefer_style][2];
+  }
+  return NULL;
+}
+
 static const char *xml_attr(cmark_syntax_extension *extension,
                             cmark_node *node) {
   if (node->type == CMARK_NODE_TABLE_CELL) {
     if (cmark_gfm_extensions_get_table_row_is_header(node->parent)) {
-      switch (get_cell_alignment(node)) {
-      case 'l': return " align=\"left\"";
-      case 'c': return " align=\"center\"";
-      case 'r': return " align=\"right\"";
-      }
+      const table_align_attr *align =
+          get_align_attr(get_cell_alignment(node), 0);
+      if (align)
+        return align->attr;
     }
   }
 
@@ -726,18 +850,6 @@ static void man_render(cmark_syntax_extension *extension,
   }
 }
 
-static void html_table_add_align(cmark_strbuf* html, const char* align, int options) {
-  if (options & CMARK_OPT_TABLE_PREFER_STYLE_ATTRIBUTES) {
-    cmark_strbuf_puts(html, " style=\"text-align: ");
-    cmark_strbuf_puts(html, align);
-    cmark_strbuf_puts(html, "\"");
-  } else {
-    cmark_strbuf_puts(html, " align=\"");
-    cmark_strbuf_puts(html, align);
-    cmark_strbuf_puts(html, "\"");
-  }
-}
-
 struct html_table_state {
   unsigned need_closing_table_body : 1;
   unsigned in_table_header : 1;
@@ -804,11 +916,11 @@ static void html_render(cmark_syntax_extension *extension,
         cmark_strbuf_puts(html, "<td");
       }
 
-      switch (get_cell_alignment(node)) {
-      case 'l': html_table_add_align(html, "left", options); break;
-      case 'c': html_table_add_align(html, "center", options); break;
-      case 'r': html_table_add_align(html, "right", options); break;
-      }
+      const table_align_attr *align = get_align_attr(
+          get_cell_alignment(node),
+          (options & CMARK_OPT_TABLE_PREFER_STYLE_ATTRIBUTES) != 0);
+      if (align)
+        cmark_strbuf_put(html, (const unsigned char *)align->attr, align->len);
 
       cmark_html_render_sourcepos(node, html, options);
       cmark_strbuf_putc(html, '>');
@@ -852,10 +964,19 @@ static int escape(cmark_syntax_extension *self, cmark_node *node, int c) {
 
 cmark_syntax_extension *create_table_extension(void) {
   cmark_syntax_extension *self = cmark_syntax_extension_new("table");
+  cmark_llist *trigger_chars = NULL;
 
   cmark_register_node_flag(&CMARK_NODE__TABLE_VISITED);
   cmark_syntax_extension_set_match_block_func(self, matches);
   cmark_syntax_extension_set_open_block_func(self, try_opening_table_block);
+
+  // A table starts with its delimiter row; rows are only opened inside
+  // tables, which are always checked.
+  cmark_mem *mem = cmark_get_default_mem_allocator();
+  trigger_chars = cmark_llist_append(mem, trigger_chars, (void *)'|');
+  trigger_chars = cmark_llist_append(mem, trigger_chars, (void *)':');
+  trigger_chars = cmark_llist_append(mem, trigger_chars, (void *)'-');
+  cmark_syntax_extension_set_block_trigger_chars(self, trigger_chars);
   cmark_syntax_extension_set_get_type_string_func(self, get_type_string);
   cmark_syntax_extension_set_can_contain_func(self, can_contain);
   cmark_syntax_extension_set_contains_inlines_func(self, contains_inlines);
@@ -868,6 +989,7 @@ cmark_syntax_extension *create_table_extension(void) {
   cmark_syntax_extension_set_opaque_alloc_func(self, opaque_alloc);
   cmark_syntax_extension_set_opaque_free_func(self, opaque_free);
   cmark_syntax_extension_set_commonmark_escape_func(self, escape);
+
   CMARK_NODE_TABLE = cmark_syntax_extension_add_node(0);
   CMARK_NODE_TABLE_ROW = cmark_syntax_extension_add_node(0);
   CMARK_NODE_TABLE_CELL = cmark_syntax_extension_add_node(0);
@@ -915,3 +1037,17 @@ int cmark_gfm_extensions_set_table_row_is_header(cmark_node *node, int is_header
   ((node_table_row *)node->as.opaque)->is_header = (is_header != 0);
   return 1;
 }
+
+int cmark_gfm_extensions_get_table_max_autocompleted_cells(
+    cmark_parser *parser) {
+  return get_max_autocompleted_cells(parser);
+}
+
+int cmark_gfm_extensions_set_table_max_autocompleted_cells(cmark_parser *parser,
+                                                           int max_cells) {
+  if (max_cells < 0)
+    return 0;
+
+  parser->table_max_autocompleted_cells = max_cells;
+  return 1;
+}
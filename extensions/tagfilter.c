@@ -1,12 +1,15 @@
 #include "tagfilter.h"
 #include <parser.h>
-#include <ctype.h>
 
 static const char *blacklist[] = {
     "title",   "textarea", "style",  "xmp",       "iframe",
     "noembed", "noframes", "script", "plaintext", NULL,
 };
 
+static unsigned char ascii_tolower(unsigned char c) {
+  return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+}
+
 static int is_tag(const unsigned char *tag_data, size_t tag_size,
                   const char *tagname) {
   size_t i;
@@ -24,7 +27,7 @@ static int is_tag(const unsigned char *tag_data, size_t tag_size,
     if (*tagname == 0)
       break;
 
-    if (tolower(tag_data[i]) != *tagname)
+    if (ascii_tolower(tag_data[i]) != *tagname)
       return 0;
   }
 
@@ -56,5 +59,6 @@ static int filter(cmark_syntax_extension *ext, const unsigned char *tag,
 cmark_syntax_extension *create_tagfilter_extension(void) {
   cmark_syntax_extension *ext = cmark_syntax_extension_new("tagfilter");
   cmark_syntax_extension_set_html_filter_func(ext, filter);
+  cmark_syntax_extension_set_html_filter_tags(ext, blacklist);
   return ext;
 }
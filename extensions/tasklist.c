@@ -142,10 +142,15 @@ static const char *xml_attr(cmark_syntax_extension *extension,
 
 cmark_syntax_extension *create_tasklist_extension(void) {
   cmark_syntax_extension *ext = cmark_syntax_extension_new("tasklist");
+  cmark_llist *trigger_chars = NULL;
 
   cmark_syntax_extension_set_match_block_func(ext, matches);
   cmark_syntax_extension_set_get_type_string_func(ext, get_type_string);
   cmark_syntax_extension_set_open_block_func(ext, open_tasklist_item);
+
+  cmark_mem *mem = cmark_get_default_mem_allocator();
+  trigger_chars = cmark_llist_append(mem, trigger_chars, (void *)'[');
+  cmark_syntax_extension_set_block_trigger_chars(ext, trigger_chars);
   cmark_syntax_extension_set_can_contain_func(ext, can_contain);
   cmark_syntax_extension_set_commonmark_render_func(ext, commonmark_render);
   cmark_syntax_extension_set_plaintext_render_func(ext, commonmark_render);
@@ -23,6 +23,7 @@
 #include "houdini.h"
 #include "buffer.h"
 #include "footnotes.h"
+#include "iterator.h"
 
 #define CODE_INDENT 4
 #define TAB_STOP 4
@@ -72,6 +73,62 @@ static CMARK_INLINE bool S_is_space_or_tab(char c) {
   return (c == ' ' || c == '\t');
 }
 
+// HTML blocks of types 1-5 end on the first line containing a fixed
+// marker.  Returns a pointer into the first such marker in [p, end), or
+// NULL.  No marker contains a line ending, so 'p' may span many lines.
+static const unsigned char *S_find_html_block_end(int html_block_type,
+                                                  const unsigned char *p,
+                                                  const unsigned char *end) {
+  static const char *const tags[] = {"script", "pre", "textarea", "style"};
+  const unsigned char *start = p, *q;
+  size_t i, j, len;
+
+  if (html_block_type == 1) {
+    // </script>, </pre>, </textarea>, </style>, case-insensitively
+    while ((q = (const unsigned char *)memchr(p, '<', end - p)) != NULL) {
+      p = q + 1;
+      if (end - p < 5 || *p != '/')
+        continue;
+      for (i = 0; i < sizeof(tags) / sizeof(tags[0]); ++i) {
+        len = strlen(tags[i]);
+        if ((size_t)(end - p) < len + 2 || p[len + 1] != '>')
+          continue;
+        // Letters are the only bytes that OR 0x20 maps to a lowercase
+        // letter.
+        for (j = 0; j < len && (p[j + 1] | 0x20) == tags[i][j]; ++j)
+          ;
+        if (j == len)
+          return q;
+      }
+    }
+    return NULL;
+  }
+
+  // -->, ?>, > and ]]> all end in '>'
+  while ((q = (const unsigned char *)memchr(p, '>', end - p)) != NULL) {
+    switch (html_block_type) {
+    case 2:
+      if (q - start >= 2 && q[-1] == '-' && q[-2] == '-')
+        return q;
+      break;
+    case 3:
+      if (q > start && q[-1] == '?')
+        return q;
+      break;
+    case 4:
+      return q;
+    case 5:
+      if (q - start >= 2 && q[-1] == ']' && q[-2] == ']')
+        return q;
+      break;
+    default:
+      return NULL;
+    }
+    p = q + 1;
+  }
+  return NULL;
+}
+
 static void S_parser_feed(cmark_parser *parser, const unsigned char *buffer,
                           size_t len, bool eof);
 
@@ -83,7 +140,8 @@ static cmark_node *make_block(cmark_mem *mem, cmark_node_type tag,
   cmark_node *e;
 
   e = (cmark_node *)mem->calloc(1, sizeof(*e));
-  cmark_strbuf_init(mem, &e->content, 32);
+  // Containers never use their content; leaves size it on the first line.
+  cmark_strbuf_init(mem, &e->content, 0);
   e->type = (uint16_t)tag;
   e->flags = CMARK_NODE__OPEN;
   e->start_line = start_line;
@@ -99,12 +157,105 @@ static cmark_node *make_document(cmark_mem *mem) {
   return e;
 }
 
+static bool S_has_special_inline_char(cmark_syntax_extension *ext,
+                                      unsigned char c) {
+  cmark_llist *tmp;
+
+  for (tmp = ext->special_inline_chars; tmp; tmp = tmp->next) {
+    if ((unsigned char)(size_t)tmp->data == c)
+      return true;
+  }
+
+  return false;
+}
+
+static void S_build_inline_dispatch(cmark_parser *parser) {
+  cmark_inline_dispatch *d = parser->inline_dispatch;
+  cmark_llist *tmp;
+  size_t n = 0;
+  int c;
+
+  if (!d)
+    d = parser->inline_dispatch = (cmark_inline_dispatch *)parser->mem->calloc(
+        1, sizeof(cmark_inline_dispatch));
+
+  for (c = 0; c < 256; ++c) {
+    d->start[c] = (uint16_t)n;
+    d->owner[c] = NULL;
+    for (tmp = parser->inline_syntax_extensions; tmp; tmp = tmp->next) {
+      cmark_syntax_extension *ext = (cmark_syntax_extension *)tmp->data;
+      bool special = S_has_special_inline_char(ext, (unsigned char)c);
+
+      if (special && !d->owner[c])
+        d->owner[c] = ext;
+      if (ext->match_inline && (special || !ext->special_inline_chars))
+        n++;
+    }
+  }
+  d->start[256] = (uint16_t)n;
+
+  parser->mem->free(d->exts);
+  d->exts = n ? (cmark_syntax_extension **)parser->mem->calloc(
+                    n, sizeof(cmark_syntax_extension *))
+              : NULL;
+
+  n = 0;
+  for (c = 0; c < 256; ++c) {
+    for (tmp = parser->inline_syntax_extensions; tmp; tmp = tmp->next) {
+      cmark_syntax_extension *ext = (cmark_syntax_extension *)tmp->data;
+
+      if (ext->match_inline &&
+          (!ext->special_inline_chars ||
+           S_has_special_inline_char(ext, (unsigned char)c)))
+        d->exts[n++] = ext;
+    }
+  }
+}
+
+static void S_free_inline_dispatch(cmark_parser *parser) {
+  if (parser->inline_dispatch) {
+    parser->mem->free(parser->inline_dispatch->exts);
+    parser->mem->free(parser->inline_dispatch);
+    parser->inline_dispatch = NULL;
+  }
+}
+
+static void S_build_block_start_chars(cmark_parser *parser) {
+  static const char core_starts[] = ">#`~<=-*_+0123456789";
+  uint8_t *starts = parser->block_start_chars;
+  cmark_llist *tmp, *chars;
+  const char *c;
+
+  memset(starts, 0, sizeof(parser->block_start_chars));
+  for (c = core_starts; *c; ++c)
+    starts[(unsigned char)*c] = 1;
+  if (parser->options & CMARK_OPT_FOOTNOTES)
+    starts['['] = 1;
+
+  for (tmp = parser->syntax_extensions; tmp; tmp = tmp->next) {
+    cmark_syntax_extension *ext = (cmark_syntax_extension *)tmp->data;
+
+    if (!ext->try_opening_block)
+      continue;
+
+    if (!ext->block_trigger_chars) {
+      memset(starts, 1, sizeof(parser->block_start_chars));
+      return;
+    }
+
+    for (chars = ext->block_trigger_chars; chars; chars = chars->next)
+      starts[(unsigned char)(size_t)chars->data] = 1;
+  }
+}
+
 int cmark_parser_attach_syntax_extension(cmark_parser *parser,
                                          cmark_syntax_extension *extension) {
   parser->syntax_extensions = cmark_llist_append(parser->mem, parser->syntax_extensions, extension);
+  S_build_block_start_chars(parser);
   if (extension->match_inline || extension->insert_inline_from_delim) {
     parser->inline_syntax_extensions = cmark_llist_append(
       parser->mem, parser->inline_syntax_extensions, extension);
+    S_build_inline_dispatch(parser);
   }
 
   return 1;
@@ -121,7 +272,15 @@ static void cmark_parser_dispose(cmark_parser *parser) {
 static void cmark_parser_reset(cmark_parser *parser) {
   cmark_llist *saved_exts = parser->syntax_extensions;
   cmark_llist *saved_inline_exts = parser->inline_syntax_extensions;
+  cmark_inline_dispatch *saved_inline_dispatch = parser->inline_dispatch;
+  cmark_inline_pool saved_inline_pool = parser->inline_pool;
+  cmark_scratch saved_scratch = parser->scratch;
+  cmark_node_list saved_footnote_defs = parser->footnote_defs;
+  cmark_node_list saved_footnote_refs = parser->footnote_refs;
   int saved_options = parser->options;
+  int saved_max_blocks = parser->max_blocks;
+  int saved_table_max_autocompleted_cells =
+      parser->table_max_autocompleted_cells;
   cmark_mem *saved_mem = parser->mem;
 
   cmark_parser_dispose(parser);
@@ -140,13 +299,25 @@ static void cmark_parser_reset(cmark_parser *parser) {
 
   parser->syntax_extensions = saved_exts;
   parser->inline_syntax_extensions = saved_inline_exts;
+  parser->inline_dispatch = saved_inline_dispatch;
+  parser->inline_pool = saved_inline_pool;
+  parser->scratch = saved_scratch;
+  parser->footnote_defs = saved_footnote_defs;
+  parser->footnote_defs.size = 0;
+  parser->footnote_refs = saved_footnote_refs;
+  parser->footnote_refs.size = 0;
   parser->options = saved_options;
+  parser->max_blocks = saved_max_blocks;
+  parser->table_max_autocompleted_cells = saved_table_max_autocompleted_cells;
+
+  S_build_block_start_chars(parser);
 }
 
 cmark_parser *cmark_parser_new_with_mem(int options, cmark_mem *mem) {
   cmark_parser *parser = (cmark_parser *)mem->calloc(1, sizeof(cmark_parser));
   parser->mem = mem;
   parser->options = options;
+  parser->table_max_autocompleted_cells = -1;
   cmark_parser_reset(parser);
   return parser;
 }
@@ -163,6 +334,11 @@ void cmark_parser_free(cmark_parser *parser) {
   cmark_strbuf_free(&parser->linebuf);
   cmark_llist_free(parser->mem, parser->syntax_extensions);
   cmark_llist_free(parser->mem, parser->inline_syntax_extensions);
+  S_free_inline_dispatch(parser);
+  cmark_inline_pool_free(mem, &parser->inline_pool);
+  cmark_scratch_free(&parser->scratch);
+  mem->free(parser->footnote_defs.items);
+  mem->free(parser->footnote_refs.items);
   mem->free(parser);
 }
 
@@ -220,6 +396,23 @@ static void add_line(cmark_node *node, cmark_chunk *ch, cmark_parser *parser) {
                    ch->len - parser->offset);
 }
 
+// The rest of a fence's opening line is the info string; it never becomes
+// part of the content.
+static void set_fenced_code_info(cmark_parser *parser, cmark_node *node,
+                                 cmark_chunk *ch) {
+  cmark_strbuf tmp = CMARK_BUF_INIT(parser->mem);
+  bufsize_t end = parser->offset;
+
+  while (end < ch->len && !S_is_line_end_char(ch->data[end]))
+    end++;
+
+  houdini_unescape_html_f(&tmp, ch->data + parser->offset, end - parser->offset);
+  cmark_strbuf_trim(&tmp);
+  cmark_strbuf_unescape(&tmp);
+  cmark_chunk_free(parser->mem, &node->as.code.info);
+  node->as.code.info = cmark_chunk_buf_detach(&tmp);
+}
+
 static void remove_trailing_blank_lines(cmark_strbuf *ln) {
   bufsize_t i;
   unsigned char c;
@@ -268,7 +461,7 @@ static bool resolve_reference_link_definitions(
                 cmark_node *b) {
   bufsize_t pos;
   cmark_strbuf *node_content = &b->content;
-  cmark_chunk chunk = {node_content->ptr, node_content->size, 0};
+  cmark_chunk chunk = {node_content->ptr, node_content->size, 0, 0};
   while (chunk.len && chunk.data[0] == '[' &&
          (pos = cmark_parse_reference_inline(parser->mem, &chunk,
 					     parser->refmap))) {
@@ -281,11 +474,11 @@ static bool resolve_reference_link_definitions(
 }
 
 static cmark_node *finalize(cmark_parser *parser, cmark_node *b) {
-  bufsize_t pos;
   cmark_node *item;
   cmark_node *subitem;
   cmark_node *parent;
   bool has_content;
+  bool kept = true;
 
   parent = b->parent;
   assert(b->flags &
@@ -319,6 +512,7 @@ static cmark_node *finalize(cmark_parser *parser, cmark_node *b) {
     if (!has_content) {
       // remove blank node (former reference def)
       cmark_node_free(b);
+      kept = false;
     }
     break;
   }
@@ -327,25 +521,6 @@ static cmark_node *finalize(cmark_parser *parser, cmark_node *b) {
     if (!b->as.code.fenced) { // indented code
       remove_trailing_blank_lines(node_content);
       cmark_strbuf_putc(node_content, '\n');
-    } else {
-      // first line of contents becomes info
-      for (pos = 0; pos < node_content->size; ++pos) {
-        if (S_is_line_end_char(node_content->ptr[pos]))
-          break;
-      }
-      assert(pos < node_content->size);
-
-      cmark_strbuf tmp = CMARK_BUF_INIT(parser->mem);
-      houdini_unescape_html_f(&tmp, node_content->ptr, pos);
-      cmark_strbuf_trim(&tmp);
-      cmark_strbuf_unescape(&tmp);
-      b->as.code.info = cmark_chunk_buf_detach(&tmp);
-
-      if (node_content->ptr[pos] == '\r')
-        pos += 1;
-      if (node_content->ptr[pos] == '\n')
-        pos += 1;
-      cmark_strbuf_drop(node_content, pos);
     }
     b->as.code.literal = cmark_chunk_buf_detach(node_content);
     break;
@@ -383,10 +558,17 @@ static cmark_node *finalize(cmark_parser *parser, cmark_node *b) {
 
     break;
 
+  case CMARK_NODE_FOOTNOTE_DEFINITION:
+    cmark_node_list_append(parser->mem, &parser->footnote_defs, b);
+    break;
+
   default:
     break;
   }
 
+  if (kept && parent == parser->root)
+    parser->n_top_level_blocks++;
+
   return parent;
 }
 
@@ -401,6 +583,16 @@ static cmark_node *add_child(cmark_parser *parser, cmark_node *parent,
     parent = finalize(parser, parent);
   }
 
+  // Earlier top-level blocks are finalized by now, except for a container
+  // that stopped matching this line: it is only closed after the new block
+  // is opened, but it can't be a paragraph, so it will be kept.
+  if (parent == parser->root && parser->max_blocks > 0 &&
+      parser->n_top_level_blocks +
+              (parent->last_child &&
+               (parent->last_child->flags & CMARK_NODE__OPEN) ? 1 : 0) >=
+          parser->max_blocks)
+    parser->truncated = true;
+
   cmark_node *child =
       make_block(parser->mem, block_type, parser->line_number, start_column);
   child->parent = parent;
@@ -436,14 +628,15 @@ void cmark_manage_extensions_special_characters(cmark_parser *parser, int add) {
 // string content into inline content where appropriate.
 static void process_inlines(cmark_parser *parser,
                             cmark_map *refmap, int options) {
-  cmark_iter *iter = cmark_iter_new(parser->root);
+  cmark_iter_storage storage;
+  cmark_iter *iter = cmark_iter_init(&storage, parser->root);
   cmark_node *cur;
   cmark_event_type ev_type;
 
   cmark_manage_extensions_special_characters(parser, true);
 
-  while ((ev_type = cmark_iter_next(iter)) != CMARK_EVENT_DONE) {
-    cur = cmark_iter_get_node(iter);
+  while ((ev_type = cmark_iter_step(iter)) != CMARK_EVENT_DONE) {
+    cur = iter->cur.node;
     if (ev_type == CMARK_EVENT_ENTER) {
       if (contains_inlines(cur)) {
         cmark_parse_inlines(parser, cur, refmap, options);
@@ -452,95 +645,125 @@ static void process_inlines(cmark_parser *parser,
   }
 
   cmark_manage_extensions_special_characters(parser, false);
+}
+
+// Formats a footnote index as the literal of a reference to it.
+static cmark_chunk S_footnote_ix_literal(cmark_mem *mem, unsigned int ix) {
+  unsigned char digits[16];
+  size_t n = sizeof(digits);
+  cmark_chunk c;
 
-  cmark_iter_free(iter);
+  do {
+    digits[--n] = (unsigned char)('0' + ix % 10);
+    ix /= 10;
+  } while (ix);
+
+  c.len = (bufsize_t)(sizeof(digits) - n);
+  c.data = (unsigned char *)mem->calloc(c.len + 1, 1);
+  c.alloc = 1;
+  c.flags = CMARK_CHUNK_NO_HTML_SPECIAL | CMARK_CHUNK_ASCII;
+  memcpy(c.data, digits + n, c.len);
+  return c;
 }
 
-static int sort_footnote_by_ix(const void *_a, const void *_b) {
-  cmark_footnote *a = *(cmark_footnote **)_a;
-  cmark_footnote *b = *(cmark_footnote **)_b;
-  return (int)a->ix - (int)b->ix;
+// Merge text into adjacent text siblings, as the inline parser does with
+// literal runs.
+static void merge_text_siblings(cmark_mem *mem, cmark_node *text) {
+  cmark_strbuf buf = CMARK_BUF_INIT(mem);
+  cmark_node *prev = text->prev;
+  cmark_node *next;
+
+  if (!(prev && prev->type == CMARK_NODE_TEXT) &&
+      !(text->next && text->next->type == CMARK_NODE_TEXT))
+    return;
+
+  if (prev && prev->type == CMARK_NODE_TEXT) {
+    cmark_strbuf_put(&buf, prev->as.literal.data, prev->as.literal.len);
+    text->start_line = prev->start_line;
+    text->start_column = prev->start_column;
+    text->end_line = prev->end_line;
+    cmark_node_free(prev);
+  }
+  cmark_strbuf_put(&buf, text->as.literal.data, text->as.literal.len);
+  while ((next = text->next) && next->type == CMARK_NODE_TEXT) {
+    cmark_strbuf_put(&buf, next->as.literal.data, next->as.literal.len);
+    text->end_column = next->end_column;
+    cmark_node_free(next);
+  }
+
+  cmark_chunk_free(mem, &text->as.literal);
+  text->as.literal = cmark_chunk_buf_detach(&buf);
 }
 
 static void process_footnotes(cmark_parser *parser) {
-  // * Collect definitions in a map.
-  // * Iterate the references in the document in order, assigning indices to
+  // * Collect definitions in a map, in the order they were closed.
+  // * Go through the references in document order, assigning indices to
   //   definitions in the order they're seen.
   // * Write out the footnotes at the bottom of the document in index order.
+  //
+  // Both lists were filled in by the block and inline parsers, so only
+  // the footnote nodes themselves are visited here.
 
-  cmark_map *map = cmark_footnote_map_new(parser->mem);
-
-  cmark_iter *iter = cmark_iter_new(parser->root);
-  cmark_node *cur;
-  cmark_event_type ev_type;
+  cmark_node_list *defs = &parser->footnote_defs;
+  cmark_node_list *refs = &parser->footnote_refs;
 
-  while ((ev_type = cmark_iter_next(iter)) != CMARK_EVENT_DONE) {
-    cur = cmark_iter_get_node(iter);
-    if (ev_type == CMARK_EVENT_EXIT && cur->type == CMARK_NODE_FOOTNOTE_DEFINITION) {
-      cmark_footnote_create(map, cur);
-    }
-  }
+  if (!defs->size && !refs->size)
+    return;
 
-  cmark_iter_free(iter);
-  iter = cmark_iter_new(parser->root);
+  cmark_map *map = cmark_footnote_map_new(parser->mem);
+  cmark_scratch_mark mark = cmark_scratch_get_mark(&parser->scratch);
+  cmark_footnote **ordered = (cmark_footnote **)cmark_scratch_alloc(
+      &parser->scratch, (defs->size ? defs->size : 1) * sizeof(cmark_footnote *));
   unsigned int ix = 0;
+  bufsize_t i;
 
-  while ((ev_type = cmark_iter_next(iter)) != CMARK_EVENT_DONE) {
-    cur = cmark_iter_get_node(iter);
-    if (ev_type == CMARK_EVENT_EXIT && cur->type == CMARK_NODE_FOOTNOTE_REFERENCE) {
-      cmark_footnote *footnote = (cmark_footnote *)cmark_map_lookup(map, &cur->as.literal);
-      if (footnote) {
-        if (!footnote->ix)
-          footnote->ix = ++ix;
-
-        // store a reference to this footnote reference's footnote definition
-        // this is used by renderers when generating label ids
-        cur->parent_footnote_def = footnote->node;
-
-        // keep track of a) count of how many times this footnote def has been
-        // referenced, and b) which reference index this footnote ref is at.
-        // this is used by renderers when generating links and backreferences.
-        cur->footnote.ref_ix = ++footnote->node->footnote.def_count;
-
-        char n[32];
-        snprintf(n, sizeof(n), "%d", footnote->ix);
-        cmark_chunk_free(parser->mem, &cur->as.literal);
-        cmark_strbuf buf = CMARK_BUF_INIT(parser->mem);
-        cmark_strbuf_puts(&buf, n);
-
-        cur->as.literal = cmark_chunk_buf_detach(&buf);
-      } else {
-        cmark_node *text = (cmark_node *)parser->mem->calloc(1, sizeof(*text));
-        cmark_strbuf_init(parser->mem, &text->content, 0);
-        text->type = (uint16_t) CMARK_NODE_TEXT;
-
-        cmark_strbuf buf = CMARK_BUF_INIT(parser->mem);
-        cmark_strbuf_puts(&buf, "[^");
-        cmark_strbuf_put(&buf, cur->as.literal.data, cur->as.literal.len);
-        cmark_strbuf_putc(&buf, ']');
-
-        text->as.literal = cmark_chunk_buf_detach(&buf);
-        cmark_node_insert_after(cur, text);
-        cmark_node_free(cur);
-      }
-    }
-  }
-
-  cmark_iter_free(iter);
+  for (i = 0; i < defs->size; ++i)
+    cmark_footnote_create(map, defs->items[i]);
 
-  if (map->sorted) {
-    qsort(map->sorted, map->size, sizeof(cmark_map_entry *), sort_footnote_by_ix);
-    for (unsigned int i = 0; i < map->size; ++i) {
-      cmark_footnote *footnote = (cmark_footnote *)map->sorted[i];
+  for (i = 0; i < refs->size; ++i) {
+    cmark_node *cur = refs->items[i];
+    cmark_footnote *footnote = (cmark_footnote *)cmark_map_lookup(map, &cur->as.literal);
+    if (footnote) {
       if (!footnote->ix) {
-        cmark_node_unlink(footnote->node);
-        continue;
+        footnote->ix = ++ix;
+        ordered[ix - 1] = footnote;
       }
-      cmark_node_append_child(parser->root, footnote->node);
-      footnote->node = NULL;
+
+      // store a reference to this footnote reference's footnote definition
+      // this is used by renderers when generating label ids
+      cur->parent_footnote_def = footnote->node;
+
+      // keep track of a) count of how many times this footnote def has been
+      // referenced, and b) which reference index this footnote ref is at.
+      // this is used by renderers when generating links and backreferences.
+      cur->footnote.ref_ix = ++footnote->node->footnote.def_count;
+
+      cmark_chunk_free(parser->mem, &cur->as.literal);
+      cur->as.literal = S_footnote_ix_literal(parser->mem, footnote->ix);
+    } else {
+      cmark_node *text = (cmark_node *)parser->mem->calloc(1, sizeof(*text));
+      cmark_strbuf_init(parser->mem, &text->content, 0);
+      text->type = (uint16_t) CMARK_NODE_TEXT;
+
+      cmark_strbuf buf = CMARK_BUF_INIT(parser->mem);
+      cmark_strbuf_puts(&buf, "[^");
+      cmark_strbuf_put(&buf, cur->as.literal.data, cur->as.literal.len);
+      cmark_strbuf_putc(&buf, ']');
+
+      text->as.literal = cmark_chunk_buf_detach(&buf);
+      cmark_node_insert_after(cur, text);
+      cmark_node_free(cur);
+      merge_text_siblings(parser->mem, text);
     }
   }
 
+  for (i = 0; i < (bufsize_t)ix; ++i) {
+    cmark_node_append_child(parser->root, ordered[i]->node);
+    ordered[i]->node = NULL;
+  }
+
+  cmark_scratch_release(&parser->scratch, mark);
+
   cmark_unlink_footnotes_map(map);
   cmark_map_free(map);
 }
@@ -698,21 +921,193 @@ void cmark_parser_feed(cmark_parser *parser, const char *buffer, size_t len) {
 }
 
 void cmark_parser_feed_reentrant(cmark_parser *parser, const char *buffer, size_t len) {
-  cmark_strbuf saved_linebuf;
+  cmark_scratch_mark mark = cmark_scratch_get_mark(&parser->scratch);
+  bufsize_t saved_size = parser->linebuf.size;
+  unsigned char *saved_linebuf =
+      (unsigned char *)cmark_scratch_alloc(&parser->scratch, saved_size);
 
-  cmark_strbuf_init(parser->mem, &saved_linebuf, 0);
-  cmark_strbuf_puts(&saved_linebuf, cmark_strbuf_cstr(&parser->linebuf));
+  if (saved_size)
+    memcpy(saved_linebuf, parser->linebuf.ptr, saved_size);
   cmark_strbuf_clear(&parser->linebuf);
 
   S_parser_feed(parser, (const unsigned char *)buffer, len, true);
 
-  cmark_strbuf_sets(&parser->linebuf, cmark_strbuf_cstr(&saved_linebuf));
-  cmark_strbuf_free(&saved_linebuf);
+  cmark_strbuf_set(&parser->linebuf, saved_linebuf, saved_size);
+  cmark_scratch_release(&parser->scratch, mark);
+}
+
+// Some lines can only continue the open leaf block, and need none of the
+// per-line work done by S_process_line: those of a top-level HTML block of
+// type 1-5 until one contains its end marker, those of a top-level fenced
+// code block until one may close it, and those of a top-level paragraph
+// while each starts with a byte that can't open a block.  Runs of such
+// lines are appended to the block's content straight from the input.
+// Validated input is excluded: an invalid sequence may swallow a marker
+// byte after replacement.
+static bool S_takes_line_runs(cmark_parser *parser) {
+  cmark_node *cur = parser->current;
+
+  if (cur->parent != parser->root || cur->extension ||
+      (parser->options & CMARK_OPT_VALIDATE_UTF8))
+    return false;
+
+  switch (S_type(cur)) {
+  case CMARK_NODE_HTML_BLOCK:
+    return cur->as.html_block_type <= 5;
+  case CMARK_NODE_CODE_BLOCK:
+    return cur->as.code.fenced;
+  case CMARK_NODE_PARAGRAPH:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Returns the start of the line after the one at p, or NULL if that line
+// doesn't end before end.  nl and cr cache the next '\n' and '\r' found
+// across calls, so that each byte of a buffer is searched at most once.
+static const unsigned char *S_next_line(const unsigned char *p,
+                                        const unsigned char *end,
+                                        const unsigned char **nl,
+                                        const unsigned char **cr) {
+  const unsigned char *eol;
+
+  if (!*nl || *nl < p) {
+    *nl = (const unsigned char *)memchr(p, '\n', end - p);
+    if (!*nl)
+      *nl = end;
+  }
+  if (!*cr || *cr < p) {
+    *cr = (const unsigned char *)memchr(p, '\r', end - p);
+    if (!*cr)
+      *cr = end;
+  }
+
+  eol = *nl < *cr ? *nl : *cr;
+  if (eol == end)
+    return NULL;
+  if (*eol == '\r' && eol + 1 < end && eol[1] == '\n')
+    return eol + 2;
+  return eol + 1;
+}
+
+// Returns the end of the run of complete lines at the start of
+// [buffer, end) that can only continue the open leaf block.
+static const unsigned char *S_leaf_line_run_end(cmark_parser *parser,
+                                                const unsigned char *buffer,
+                                                const unsigned char *end,
+                                                const unsigned char **nl,
+                                                const unsigned char **cr) {
+  cmark_node *leaf = parser->current;
+  const unsigned char *line, *next, *p;
+
+  if (S_type(leaf) == CMARK_NODE_HTML_BLOCK) {
+    line = S_find_html_block_end(leaf->as.html_block_type, buffer, end);
+    if (!line)
+      line = end;
+    while (line > buffer && !S_is_line_end_char(line[-1]))
+      line--;
+    return line;
+  }
+
+  for (line = buffer; line < end; line = next) {
+    p = line;
+    if (S_type(leaf) == CMARK_NODE_CODE_BLOCK) {
+      // Leave lines with indentation to strip, and possible closing
+      // fences, to S_process_line.
+      if (leaf->as.code.fence_offset > 0 && S_is_space_or_tab(*p))
+        break;
+      while (p < end && S_is_space_or_tab(*p))
+        p++;
+      if (p < end && *p == leaf->as.code.fence_char)
+        break;
+    } else if (S_is_space_or_tab(*p) || S_is_line_end_char(*p) || !*p ||
+               parser->block_start_chars[*p]) {
+      break;
+    }
+    next = S_next_line(line, end, nl, cr);
+    if (!next)
+      break;
+  }
+
+  return line;
+}
+
+// Appends the run of lines found by S_leaf_line_run_end straight to the
+// open leaf block's content, exactly as S_process_line would have: in one
+// piece when the input needs no normalization, line by line otherwise.
+// Returns the number of bytes consumed.
+static bufsize_t S_add_leaf_lines(cmark_parser *parser,
+                                  const unsigned char *buffer,
+                                  const unsigned char *end,
+                                  const unsigned char **nl,
+                                  const unsigned char **cr) {
+  static const uint8_t repl[] = {239, 191, 189};
+  cmark_node *block = parser->current;
+  const unsigned char *stop, *line, *p;
+  bufsize_t line_start;
+  bool blank = false;
+
+  stop = S_leaf_line_run_end(parser, buffer, end, nl, cr);
+  if (stop == buffer)
+    return 0;
+
+  if (!memchr(buffer, '\r', stop - buffer) &&
+      !memchr(buffer, '\0', stop - buffer)) {
+    cmark_strbuf_put(&block->content, buffer, (bufsize_t)(stop - buffer));
+    line = buffer;
+    while ((p = (const unsigned char *)memchr(line, '\n', stop - line)) !=
+           NULL) {
+      parser->line_number++;
+      if (p + 1 == stop)
+        break;
+      line = p + 1;
+    }
+    parser->last_line_length = (bufsize_t)(stop - 1 - line);
+  } else {
+    // Normalize line endings and replace NULs the way the line splitter
+    // in S_parser_feed does.
+    line = buffer;
+    while (line < stop) {
+      line_start = block->content.size;
+      for (p = line; !S_is_line_end_char(*p); ++p) {
+        if (*p == '\0') {
+          cmark_strbuf_put(&block->content, line, (bufsize_t)(p - line));
+          cmark_strbuf_put(&block->content, repl, 3);
+          line = p + 1;
+        }
+      }
+      cmark_strbuf_put(&block->content, line, (bufsize_t)(p - line));
+      parser->last_line_length = block->content.size - line_start;
+      cmark_strbuf_putc(&block->content, '\n');
+      parser->line_number++;
+      line = p + 1;
+      if (*p == '\r' && line < stop && *line == '\n')
+        line++;
+    }
+    line = block->content.ptr + block->content.size - 1 -
+           parser->last_line_length;
+  }
+
+  // Track blankness of the last line like add_text_to_container.  Lines
+  // of fenced code never count, and paragraph lines here aren't blank.
+  if (S_type(block) == CMARK_NODE_HTML_BLOCK) {
+    for (p = line, blank = true; blank && !S_is_line_end_char(*p); ++p)
+      blank = S_is_space_or_tab(*p);
+  }
+  S_set_last_line_blank(block, blank);
+  S_set_last_line_blank(parser->root, false);
+
+  if (stop == end && end[-1] == '\r')
+    parser->last_buffer_ended_with_cr = true;
+
+  return (bufsize_t)(stop - buffer);
 }
 
 static void S_parser_feed(cmark_parser *parser, const unsigned char *buffer,
                           size_t len, bool eof) {
   const unsigned char *end = buffer + len;
+  const unsigned char *next_nl = NULL, *next_cr = NULL;
   static const uint8_t repl[] = {239, 191, 189};
 
   if (len > UINT_MAX - parser->total_size)
@@ -720,6 +1115,9 @@ static void S_parser_feed(cmark_parser *parser, const unsigned char *buffer,
   else
     parser->total_size += len;
 
+  if (parser->truncated)
+    return;
+
   if (parser->last_buffer_ended_with_cr && *buffer == '\n') {
     // skip NL if last buffer ended with CR ; see #117
     buffer++;
@@ -729,6 +1127,13 @@ static void S_parser_feed(cmark_parser *parser, const unsigned char *buffer,
     const unsigned char *eol;
     bufsize_t chunk_len;
     bool process = false;
+
+    if (parser->linebuf.size == 0 && S_takes_line_runs(parser)) {
+      buffer += S_add_leaf_lines(parser, buffer, end, &next_nl, &next_cr);
+      if (buffer == end)
+        break;
+    }
+
     for (eol = buffer; eol < end; ++eol) {
       if (S_is_line_end_char(*eol)) {
         process = true;
@@ -751,6 +1156,8 @@ static void S_parser_feed(cmark_parser *parser, const unsigned char *buffer,
       } else {
         S_process_line(parser, buffer, chunk_len);
       }
+      if (parser->truncated)
+        return;
     } else {
       if (eol < end && *eol == '\0') {
         // omit NULL byte
@@ -1135,6 +1542,13 @@ static void open_new_blocks(cmark_parser *parser, cmark_node **container,
     S_find_first_nonspace(parser, input);
     indented = parser->indent >= CODE_INDENT;
 
+    // Most lines are paragraph continuations whose first byte can't start
+    // any block: skip the cascade of block start checks for them.
+    if (!indented &&
+        !parser->block_start_chars[peek_at(input, parser->first_nonspace)] &&
+        !(*container)->extension)
+      break;
+
     if (!indented && peek_at(input, parser->first_nonspace) == '>') {
 
       bufsize_t blockquote_startpos = parser->first_nonspace;
@@ -1384,41 +1798,19 @@ static void add_text_to_container(cmark_parser *parser, cmark_node *container,
     }
 
     if (S_type(container) == CMARK_NODE_CODE_BLOCK) {
-      add_line(container, input, parser);
+      if (container->as.code.fenced &&
+          container->start_line == parser->line_number)
+        set_fenced_code_info(parser, container, input);
+      else
+        add_line(container, input, parser);
     } else if (S_type(container) == CMARK_NODE_HTML_BLOCK) {
       add_line(container, input, parser);
 
-      int matches_end_condition;
-      switch (container->as.html_block_type) {
-      case 1:
-        // </script>, </style>, </pre>
-        matches_end_condition =
-            scan_html_block_end_1(input, parser->first_nonspace);
-        break;
-      case 2:
-        // -->
-        matches_end_condition =
-            scan_html_block_end_2(input, parser->first_nonspace);
-        break;
-      case 3:
-        // ?>
-        matches_end_condition =
-            scan_html_block_end_3(input, parser->first_nonspace);
-        break;
-      case 4:
-        // >
-        matches_end_condition =
-            scan_html_block_end_4(input, parser->first_nonspace);
-        break;
-      case 5:
-        // ]]>
-        matches_end_condition =
-            scan_html_block_end_5(input, parser->first_nonspace);
-        break;
-      default:
-        matches_end_condition = 0;
-        break;
-      }
+      int matches_end_condition =
+          container->as.html_block_type <= 5 &&
+          S_find_html_block_end(container->as.html_block_type,
+                                input->data + parser->first_nonspace,
+                                input->data + input->len) != NULL;
 
       if (matches_end_condition) {
         container = finalize(parser, container);
@@ -1447,9 +1839,45 @@ static void add_text_to_container(cmark_parser *parser, cmark_node *container,
   }
 }
 
+// The line that exceeded the block budget opened a new top-level block;
+// everything before it is already finalized, so discarding that block
+// leaves exactly 'max_blocks' complete blocks under the root.
+static void S_drop_over_budget_block(cmark_parser *parser) {
+  cmark_node *last = parser->root->last_child;
+  cmark_node *node;
+
+  if (!last || last->start_line != parser->line_number)
+    last = NULL;
+
+  // Close whatever is still open outside of the discarded block.
+  for (node = parser->current; node && node != last; node = node->parent)
+    ;
+  node = node ? last->parent : parser->current;
+  while (node != parser->root)
+    node = finalize(parser, node);
+  parser->current = parser->root;
+
+  if (last) {
+    // Forget the footnote definitions already closed inside the discarded
+    // block; they are the last ones recorded.
+    while (parser->footnote_defs.size) {
+      node = parser->footnote_defs.items[parser->footnote_defs.size - 1];
+      while (node && node != last)
+        node = node->parent;
+      if (!node)
+        break;
+      parser->footnote_defs.size--;
+    }
+
+    cmark_node_unlink(last);
+    cmark_node_free(last);
+  }
+}
+
 /* See http://spec.commonmark.org/0.24/#phase-1-block-structure */
 static void S_process_line(cmark_parser *parser, const unsigned char *buffer,
                            bufsize_t bytes) {
+  cmark_scratch_mark mark = cmark_scratch_get_mark(&parser->scratch);
   cmark_node *last_matched_container;
   bool all_matched = true;
   cmark_node *container;
@@ -1481,6 +1909,7 @@ static void S_process_line(cmark_parser *parser, const unsigned char *buffer,
   input.data = parser->curline.ptr;
   input.len = parser->curline.size;
   input.alloc = 0;
+  input.flags = 0;
 
   // Skip UTF-8 BOM.
   if (parser->line_number == 0 &&
@@ -1505,6 +1934,9 @@ static void S_process_line(cmark_parser *parser, const unsigned char *buffer,
   if (current == parser->current)
   add_text_to_container(parser, container, last_matched_container, &input);
 
+  if (parser->truncated)
+    S_drop_over_budget_block(parser);
+
 finished:
   parser->last_line_length = input.len;
   if (parser->last_line_length &&
@@ -1515,24 +1947,109 @@ finished:
     parser->last_line_length -= 1;
 
   cmark_strbuf_clear(&parser->curline);
+  cmark_scratch_release(&parser->scratch, mark);
+}
+
+static bool S_wants_node_type(cmark_syntax_extension *ext,
+                              cmark_node_type type) {
+  const cmark_node_type *t = ext->postprocess_node_types;
+
+  if (!t)
+    return true;
+  for (; *t != CMARK_NODE_NONE; ++t)
+    if (*t == type)
+      return true;
+  return false;
+}
+
+static bool S_wants_inlines(cmark_syntax_extension *ext) {
+  const cmark_node_type *t = ext->postprocess_node_types;
+
+  if (!t)
+    return true;
+  for (; *t != CMARK_NODE_NONE; ++t)
+    if ((*t & CMARK_NODE_TYPE_MASK) == CMARK_NODE_TYPE_INLINE)
+      return true;
+  return false;
+}
+
+// Runs the node postprocess hooks of the extensions from 'first' up to
+// 'last' (excluded) in a single traversal of the document.  The next node
+// is only determined once the hooks for the current one have returned, so
+// they may add nodes after it or below it.
+static void S_postprocess_nodes(cmark_parser *parser, cmark_llist *first,
+                                cmark_llist *last) {
+  cmark_node *node = parser->root;
+  cmark_event_type ev_type = CMARK_EVENT_ENTER;
+  cmark_syntax_extension *ext;
+  cmark_scratch_mark mark;
+  cmark_node *processed;
+  cmark_llist *it;
+  bool inlines = false;
+  bool at_root;
+
+  for (it = first; it != last; it = it->next) {
+    ext = (cmark_syntax_extension *)it->data;
+    if (ext->postprocess_node_func && S_wants_inlines(ext))
+      inlines = true;
+  }
+
+  for (;;) {
+    at_root = node == parser->root;
+    for (it = first; it != last; it = it->next) {
+      ext = (cmark_syntax_extension *)it->data;
+      if (!ext->postprocess_node_func ||
+          !S_wants_node_type(ext, (cmark_node_type)node->type))
+        continue;
+      mark = cmark_scratch_get_mark(&parser->scratch);
+      processed = ext->postprocess_node_func(ext, parser, node, ev_type);
+      cmark_scratch_release(&parser->scratch, mark);
+      if (processed)
+        node = processed;
+    }
+    if (at_root)
+      parser->root = node;
+
+    if (ev_type == CMARK_EVENT_ENTER && !cmark_iter_is_leaf(node)) {
+      if (node->first_child &&
+          (inlines || (node->first_child->type & CMARK_NODE_TYPE_MASK) !=
+                          CMARK_NODE_TYPE_INLINE))
+        node = node->first_child;
+      else
+        ev_type = CMARK_EVENT_EXIT;
+    } else if (node == parser->root) {
+      break;
+    } else if (node->next) {
+      node = node->next;
+      ev_type = CMARK_EVENT_ENTER;
+    } else {
+      node = node->parent;
+      ev_type = CMARK_EVENT_EXIT;
+    }
+  }
 }
 
 cmark_node *cmark_parser_finish(cmark_parser *parser) {
+  cmark_scratch_mark mark;
   cmark_node *res;
   cmark_llist *extensions;
+  cmark_llist *node_hooks = NULL;
 
   /* Parser was already finished once */
   if (parser->root == NULL)
     return NULL;
 
-  if (parser->linebuf.size) {
+  if (parser->linebuf.size && !parser->truncated) {
     S_process_line(parser, parser->linebuf.ptr, parser->linebuf.size);
     cmark_strbuf_clear(&parser->linebuf);
   }
 
+  mark = cmark_scratch_get_mark(&parser->scratch);
   finalize_document(parser);
+  cmark_scratch_release(&parser->scratch, mark);
 
-  cmark_consolidate_text_nodes(parser->root);
+  if (parser->truncated)
+    parser->root->flags |= CMARK_NODE__TRUNCATED;
 
   cmark_strbuf_free(&parser->curline);
   cmark_strbuf_free(&parser->linebuf);
@@ -1543,14 +2060,29 @@ cmark_node *cmark_parser_finish(cmark_parser *parser) {
   }
 #endif
 
+  // Whole-tree hooks run in attachment order; the node hooks of the
+  // extensions between two of them share one traversal.
   for (extensions = parser->syntax_extensions; extensions; extensions = extensions->next) {
     cmark_syntax_extension *ext = (cmark_syntax_extension *) extensions->data;
     if (ext->postprocess_func) {
-      cmark_node *processed = ext->postprocess_func(ext, parser, parser->root);
+      cmark_node *processed;
+
+      if (node_hooks) {
+        S_postprocess_nodes(parser, node_hooks, extensions);
+        node_hooks = NULL;
+      }
+
+      mark = cmark_scratch_get_mark(&parser->scratch);
+      processed = ext->postprocess_func(ext, parser, parser->root);
       if (processed)
         parser->root = processed;
+      cmark_scratch_release(&parser->scratch, mark);
     }
+    if (ext->postprocess_node_func && !node_hooks)
+      node_hooks = extensions;
   }
+  if (node_hooks)
+    S_postprocess_nodes(parser, node_hooks, NULL);
 
   res = parser->root;
   parser->root = NULL;
@@ -1560,6 +2092,10 @@ cmark_node *cmark_parser_finish(cmark_parser *parser) {
   return res;
 }
 
+void *cmark_parser_scratch_alloc(cmark_parser *parser, size_t size) {
+  return cmark_scratch_alloc(&parser->scratch, size);
+}
+
 int cmark_parser_get_line_number(cmark_parser *parser) {
   return parser->line_number;
 }
@@ -1612,6 +2148,10 @@ void cmark_parser_advance_offset(cmark_parser *parser,
   S_advance_offset(parser, &input_chunk, count, columns != 0);
 }
 
+void cmark_parser_set_max_blocks(cmark_parser *parser, int max_blocks) {
+  parser->max_blocks = max_blocks;
+}
+
 void cmark_parser_set_backslash_ispunct_func(cmark_parser *parser,
                                              cmark_ispunct_func func) {
   parser->backslash_ispunct = func;
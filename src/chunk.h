@@ -9,12 +9,23 @@
 #include "cmark_ctype.h"
 
 #define CMARK_CHUNK_EMPTY                                                      \
-  { NULL, 0, 0 }
+  { NULL, 0, 0, 0 }
+
+// Facts about a chunk's bytes that the parser learns while scanning them,
+// so that renderers need not look again.  A chunk holding new data has
+// none of them; a prefix or suffix of a chunk keeps those it had.
+enum cmark_chunk_flags {
+  // None of the bytes is escaped in HTML or XML text: & < > "
+  CMARK_CHUNK_NO_HTML_SPECIAL = (1 << 0),
+  // All of the bytes are below 0x80.
+  CMARK_CHUNK_ASCII = (1 << 1),
+};
 
 typedef struct cmark_chunk {
   unsigned char *data;
   bufsize_t len;
-  bufsize_t alloc; // also implies a NULL-terminated string
+  uint8_t alloc; // also implies a NULL-terminated string
+  uint8_t flags; // cmark_chunk_flags
 } cmark_chunk;
 
 static CMARK_INLINE void cmark_chunk_free(cmark_mem *mem, cmark_chunk *c) {
@@ -23,6 +34,7 @@ static CMARK_INLINE void cmark_chunk_free(cmark_mem *mem, cmark_chunk *c) {
 
   c->data = NULL;
   c->alloc = 0;
+  c->flags = 0;
   c->len = 0;
 }
 
@@ -79,6 +91,7 @@ static CMARK_INLINE const char *cmark_chunk_to_cstr(cmark_mem *mem,
 static CMARK_INLINE void cmark_chunk_set_cstr(cmark_mem *mem, cmark_chunk *c,
                                               const char *str) {
   unsigned char *old = c->alloc ? c->data : NULL;
+  c->flags = 0;
   if (str == NULL) {
     c->len = 0;
     c->data = NULL;
@@ -96,13 +109,13 @@ static CMARK_INLINE void cmark_chunk_set_cstr(cmark_mem *mem, cmark_chunk *c,
 
 static CMARK_INLINE cmark_chunk cmark_chunk_literal(const char *data) {
   bufsize_t len = data ? (bufsize_t)strlen(data) : 0;
-  cmark_chunk c = {(unsigned char *)data, len, 0};
+  cmark_chunk c = {(unsigned char *)data, len, 0, 0};
   return c;
 }
 
 static CMARK_INLINE cmark_chunk cmark_chunk_dup(const cmark_chunk *ch,
                                                 bufsize_t pos, bufsize_t len) {
-  cmark_chunk c = {ch->data + pos, len, 0};
+  cmark_chunk c = {ch->data + pos, len, 0, 0};
   return c;
 }
 
@@ -112,6 +125,7 @@ static CMARK_INLINE cmark_chunk cmark_chunk_buf_detach(cmark_strbuf *buf) {
   c.len = buf->size;
   c.data = cmark_strbuf_detach(buf);
   c.alloc = 1;
+  c.flags = 0;
 
   return c;
 }
@@ -65,6 +65,16 @@ typedef struct cmark_plugin cmark_plugin;
  * If no function was provided is NULL, the extension will have
  * no effect at all on the final block structure of the AST.
  *
+ * An extension can declare the bytes its blocks may start with
+ * (the first non-space character of a line that isn't indented)
+ * through 'cmark_syntax_extension_set_block_trigger_chars'.  Lines
+ * starting with any other byte then skip the block start checks
+ * entirely, unless they are indented or the innermost matched
+ * container belongs to an extension.  Extensions that open blocks
+ * without declaring trigger characters disable this shortcut.
+ * Like the special inline characters, trigger characters are read
+ * when the extension is attached to a parser.
+ *
  * #### Inline parsing phase hooks
  *
  * For each character provided by the extension through
@@ -73,7 +83,10 @@ typedef struct cmark_plugin cmark_plugin;
  * 'cmark_syntax_extension_set_match_inline_func'
  * will get called, it is the responsibility of the extension
  * to scan the characters located at the current inline parsing offset
- * with the cmark_inline_parser API.
+ * with the cmark_inline_parser API.  The special characters are read
+ * when the extension is attached to a parser, so they must be set
+ * before calling 'cmark_parser_attach_syntax_extension'.  An extension
+ * that provides no special characters is tried at every position.
  *
  * Depending on the type of the extension, it can either:
  *
@@ -102,6 +115,39 @@ typedef struct cmark_plugin cmark_plugin;
  * Finally, the extension should return NULL if its scan didn't
  * match its syntax rules.
  *
+ * #### Postprocessing hooks
+ *
+ * Once the document is parsed, cmark calls the function provided
+ * through 'cmark_syntax_extension_set_postprocess_func' with the
+ * root of the document, which it may walk and rewrite as it sees fit.
+ *
+ * Extensions that only need to look at some nodes should rather
+ * provide a function through
+ * 'cmark_syntax_extension_set_postprocess_node_func', and list the
+ * node types it applies to with
+ * 'cmark_syntax_extension_set_postprocess_node_types'.  Consecutive
+ * extensions (in attachment order) providing such functions share a
+ * single traversal of the document, in which each node gets the same
+ * events as from a cmark_iter, dispatched to the interested extensions
+ * in turn.  If none of them wants any inline node type, inline content
+ * isn't visited at all.
+ *
+ * The function returns the node that stands in place of 'node'
+ * afterwards: 'node' itself, or a node it put at its place in the tree
+ * before unlinking 'node'; NULL also keeps 'node'.  The traversal
+ * continues from the returned node, so nodes inserted after it, or below
+ * it on an ENTER event, are visited next.  Nodes that have not been
+ * visited yet must not otherwise be removed or moved.
+ *
+ * Work that only concerns the inline content of each block can be done
+ * as that content is parsed instead, through
+ * 'cmark_syntax_extension_set_postprocess_inlines_func'.  The function
+ * is called with each block whose inlines were just parsed, once
+ * emphasis is resolved and adjacent text nodes are merged; the block's
+ * unparsed content is still available through
+ * 'cmark_node_get_string_content'.  It may rewrite the inlines
+ * below the block.
+ *
  * The extension can store whatever private data it might need
  * with 'cmark_syntax_extension_set_private',
  * and optionally define a free function for this data.
@@ -254,6 +300,15 @@ typedef cmark_node *(*cmark_postprocess_func) (cmark_syntax_extension *extension
                                                cmark_parser *parser,
                                                cmark_node *root);
 
+typedef cmark_node *(*cmark_postprocess_node_func) (cmark_syntax_extension *extension,
+                                                    cmark_parser *parser,
+                                                    cmark_node *node,
+                                                    cmark_event_type ev_type);
+
+typedef void (*cmark_postprocess_inlines_func) (cmark_syntax_extension *extension,
+                                                cmark_parser *parser,
+                                                cmark_node *parent);
+
 typedef int (*cmark_ispunct_func) (char c);
 
 typedef void (*cmark_opaque_alloc_func) (cmark_syntax_extension *extension,
@@ -310,6 +365,12 @@ CMARK_GFM_EXPORT
 void cmark_syntax_extension_set_special_inline_chars(cmark_syntax_extension *extension,
                                                      cmark_llist *special_chars);
 
+/** See the documentation for 'cmark_syntax_extension'
+ */
+CMARK_GFM_EXPORT
+void cmark_syntax_extension_set_block_trigger_chars(cmark_syntax_extension *extension,
+                                                    cmark_llist *trigger_chars);
+
 /** See the documentation for 'cmark_syntax_extension'
  */
 CMARK_GFM_EXPORT
@@ -370,6 +431,22 @@ CMARK_GFM_EXPORT
 void cmark_syntax_extension_set_html_filter_func(cmark_syntax_extension *extension,
                                                  cmark_html_filter_func func);
 
+/** Registers the names of the HTML tags 'extension' filters out of raw
+ * HTML, as a NULL-terminated array.  Names may contain ASCII letters,
+ * digits and '-', and are matched case-insensitively.  The array is
+ * copied.  Passing NULL (the default) clears the set.
+ *
+ * The HTML renderer compiles the tag sets of all the extensions it is
+ * given into a single matcher, and uses it instead of calling
+ * 'html_filter_func' for these extensions.
+ *
+ * Returns 1 on success, 0 if a name is empty or invalid, in which case
+ * the previous set is kept.
+ */
+CMARK_GFM_EXPORT
+int cmark_syntax_extension_set_html_filter_tags(cmark_syntax_extension *extension,
+                                                const char **tags);
+
 /** See the documentation for 'cmark_syntax_extension'
  */
 CMARK_GFM_EXPORT
@@ -394,6 +471,27 @@ CMARK_GFM_EXPORT
 void cmark_syntax_extension_set_postprocess_func(cmark_syntax_extension *extension,
                                                  cmark_postprocess_func func);
 
+/** See the documentation for 'cmark_syntax_extension'
+ */
+CMARK_GFM_EXPORT
+void cmark_syntax_extension_set_postprocess_node_func(cmark_syntax_extension *extension,
+                                                      cmark_postprocess_node_func func);
+
+/** See the documentation for 'cmark_syntax_extension'
+ */
+CMARK_GFM_EXPORT
+void cmark_syntax_extension_set_postprocess_inlines_func(cmark_syntax_extension *extension,
+                                                         cmark_postprocess_inlines_func func);
+
+/** Sets the node types the function set with
+ * 'cmark_syntax_extension_set_postprocess_node_func' is called for, as an
+ * array terminated by CMARK_NODE_NONE.  The array is copied.  Passing NULL
+ * (the default) selects every node.
+ */
+CMARK_GFM_EXPORT
+void cmark_syntax_extension_set_postprocess_node_types(cmark_syntax_extension *extension,
+                                                       const cmark_node_type *types);
+
 /** See the documentation for 'cmark_syntax_extension'
  */
 CMARK_GFM_EXPORT
@@ -570,6 +668,18 @@ void cmark_parser_advance_offset(cmark_parser *parser,
 CMARK_GFM_EXPORT
 void cmark_parser_feed_reentrant(cmark_parser *parser, const char *buffer, size_t len);
 
+/** Allocate 'size' zero-initialized bytes of scratch memory, for data that
+ * is only needed while the 'parser' is busy with the current line or block.
+ *
+ * Scratch memory isn't taken from the parser's allocator, so it doesn't add
+ * to the memory footprint of the document, and must not be freed.  It is
+ * all released at once: after each line has been processed (for callbacks
+ * made during block parsing), after the inlines of each block are parsed
+ * (for inline callbacks), and after each postprocess callback returns.
+ */
+CMARK_GFM_EXPORT
+void *cmark_parser_scratch_alloc(cmark_parser *parser, size_t size);
+
 /** Attach the syntax 'extension' to the 'parser', to provide extra syntax
  *  rules.
  *  See the documentation for cmark_syntax_extension for more information.
@@ -665,11 +775,70 @@ CMARK_GFM_EXPORT
 int cmark_inline_parser_is_eof(cmark_inline_parser *parser);
 
 /** Get the characters located after the current inline parsing offset
- * while 'pred' matches. Free after usage.
+ * while 'pred' matches. The result is allocated with malloc; free after
+ * usage.  Prefer cmark_inline_parser_take_while_span, which doesn't copy.
  */
 CMARK_GFM_EXPORT
 char *cmark_inline_parser_take_while(cmark_inline_parser *parser, cmark_inline_predicate pred);
 
+/** A slice of the text being parsed by an inline parser.  'data' points
+ * into the parser's chunk and is not NUL-terminated; it stays valid while
+ * the inlines of the current block are being parsed.
+ */
+typedef struct cmark_inline_span {
+  const unsigned char *data;
+  int len;
+} cmark_inline_span;
+
+/** A set of bytes, for the scanning helpers below.  Build it once with
+ * cmark_inline_byte_set_init and reuse it.
+ */
+typedef struct cmark_inline_byte_set {
+  unsigned char bits[32];
+} cmark_inline_byte_set;
+
+/** Initialize 'set' to contain exactly the bytes of the NUL-terminated
+ * string 'bytes'.
+ */
+CMARK_GFM_EXPORT
+void cmark_inline_byte_set_init(cmark_inline_byte_set *set, const char *bytes);
+
+/** Like cmark_inline_parser_take_while, but return the matched characters
+ * as a span of the chunk instead of a copy.  Nothing needs to be freed.
+ */
+CMARK_GFM_EXPORT
+cmark_inline_span cmark_inline_parser_take_while_span(cmark_inline_parser *parser,
+                                                      cmark_inline_predicate pred);
+
+/** Advance the inline parsing offset past the bytes that are in 'set' and
+ * return them as a span of the chunk.
+ */
+CMARK_GFM_EXPORT
+cmark_inline_span cmark_inline_parser_take_while_in_set(cmark_inline_parser *parser,
+                                                        const cmark_inline_byte_set *set);
+
+/** Return the span of at most 'len' bytes starting at 'offset' in the
+ * chunk.  Both are clamped to the bounds of the chunk.
+ */
+CMARK_GFM_EXPORT
+cmark_inline_span cmark_inline_parser_get_span(cmark_inline_parser *parser,
+                                               int offset, int len);
+
+/** Return the offset of the first 'c' at or after the current inline
+ * parsing offset, or the length of the chunk if there is none.  The
+ * parsing offset is not changed.
+ */
+CMARK_GFM_EXPORT
+int cmark_inline_parser_find_byte(cmark_inline_parser *parser, unsigned char c);
+
+/** Return the offset of the first byte in 'set' at or after the current
+ * inline parsing offset, or the length of the chunk if there is none.
+ * The parsing offset is not changed.
+ */
+CMARK_GFM_EXPORT
+int cmark_inline_parser_find_in_set(cmark_inline_parser *parser,
+                                    const cmark_inline_byte_set *set);
+
 /** Push a delimiter on the delimiter stack.
  * See <<http://spec.commonmark.org/0.24/#phase-2-inline-structure> for
  * more information on the parameters
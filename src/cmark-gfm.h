@@ -290,6 +290,21 @@ typedef enum {
 CMARK_GFM_EXPORT
 cmark_iter *cmark_iter_new(cmark_node *root);
 
+/** Storage for an iterator that doesn't need to be allocated, for
+ * example on the stack.  Its contents are private.
+ */
+typedef struct cmark_iter_storage {
+  void *opaque[6];
+} cmark_iter_storage;
+
+/** Initializes an iterator starting at 'root' in 'storage', and returns
+ * it, or NULL if 'root' is NULL.  The iterator works like one created
+ * with 'cmark_iter_new', and stays valid as long as 'storage' does.  It
+ * must not be passed to 'cmark_iter_free'.
+ */
+CMARK_GFM_EXPORT
+cmark_iter *cmark_iter_init(cmark_iter_storage *storage, cmark_node *root);
+
 /** Frees the memory allocated for an iterator.
  */
 CMARK_GFM_EXPORT
@@ -594,6 +609,22 @@ void cmark_parser_feed(cmark_parser *parser, const char *buffer, size_t len);
 CMARK_GFM_EXPORT
 cmark_node *cmark_parser_finish(cmark_parser *parser);
 
+/** Limit 'parser' to the first 'max_blocks' top-level blocks of the
+ * document, which is useful for rendering previews of large inputs.
+ * Paragraphs made only of link reference definitions don't count.
+ * Once the limit is exceeded, the rest of the input is ignored without
+ * being parsed. A value of 0 (the default) means no limit. The limit
+ * persists across calls to 'cmark_parser_finish'.
+ */
+CMARK_GFM_EXPORT
+void cmark_parser_set_max_blocks(cmark_parser *parser, int max_blocks);
+
+/** Returns 1 if 'node' is a document that was cut short by
+ * 'cmark_parser_set_max_blocks', 0 otherwise.
+ */
+CMARK_GFM_EXPORT
+int cmark_node_get_truncated(cmark_node *node);
+
 /** Parse a CommonMark document in 'buffer' of length 'len'.
  * Returns a pointer to a tree of nodes.  The memory allocated for
  * the node tree should be released using 'cmark_node_free'
@@ -638,6 +669,121 @@ char *cmark_render_html(cmark_node *root, int options, cmark_llist *extensions);
 CMARK_GFM_EXPORT
 char *cmark_render_html_with_mem(cmark_node *root, int options, cmark_llist *extensions, cmark_mem *mem);
 
+/** As for 'cmark_render_html', but stops rendering once 'max_len' bytes
+ * of output have been produced.  Text and code that would run past
+ * 'max_len' are cut at a character boundary, raw HTML that would is
+ * left out, and nothing after them is rendered.  All elements that are
+ * open at that point are closed, so the result is still well-formed
+ * HTML; it may therefore be somewhat longer than 'max_len'.  If
+ * 'truncated' is not NULL, it is set to 1 when content was left out,
+ * either here or by 'cmark_parser_set_max_blocks', and to 0 otherwise.
+ *
+ * This bounds the rendering only: the whole document has been parsed
+ * by then.  To bound the cost of an excerpt of untrusted input, parse
+ * it with 'cmark_parser_set_max_blocks' set as well.
+ */
+CMARK_GFM_EXPORT
+char *cmark_render_html_excerpt(cmark_node *root, int options,
+                                cmark_llist *extensions, size_t max_len,
+                                int *truncated);
+
+/** Receives rendered output, in order, from the '_to_writer' renderers.
+ * 'data' is only valid for the duration of the call.  Return 0 on
+ * success; any other value stops rendering.
+ */
+typedef int (*cmark_write_func)(const char *data, size_t len, void *user_data);
+
+/** As for 'cmark_render_html', but passes the output to 'write' in
+ * pieces as it is produced, so that it is never held in memory as a
+ * whole.  Returns 1 on success, or 0 if 'write' returned an error; the
+ * output is then incomplete.
+ */
+CMARK_GFM_EXPORT
+int cmark_render_html_to_writer(cmark_node *root, int options,
+                                cmark_llist *extensions, cmark_write_func write,
+                                void *user_data);
+
+typedef struct cmark_html_buffer cmark_html_buffer;
+
+/** Creates an empty buffer for 'cmark_render_html_to_buffer', using the
+ * allocator 'mem'.  A buffer keeps its memory from one rendering to the
+ * next, so it can be reused across documents without reallocating.
+ */
+CMARK_GFM_EXPORT
+cmark_html_buffer *cmark_html_buffer_new_with_mem(cmark_mem *mem);
+
+/** As for 'cmark_html_buffer_new_with_mem', using the default allocator.
+ */
+CMARK_GFM_EXPORT
+cmark_html_buffer *cmark_html_buffer_new(void);
+
+/** As for 'cmark_render_html', but renders into 'buffer', replacing its
+ * contents.
+ */
+CMARK_GFM_EXPORT
+void cmark_render_html_to_buffer(cmark_html_buffer *buffer, cmark_node *root,
+                                 int options, cmark_llist *extensions);
+
+/** Returns the contents of 'buffer' as a NUL-terminated string.  It is
+ * valid until 'buffer' is next rendered into, reset or freed.
+ */
+CMARK_GFM_EXPORT
+const char *cmark_html_buffer_data(const cmark_html_buffer *buffer);
+
+/** Returns the length of the contents of 'buffer'.
+ */
+CMARK_GFM_EXPORT
+size_t cmark_html_buffer_len(const cmark_html_buffer *buffer);
+
+/** Empties 'buffer', keeping its memory for the next rendering.
+ */
+CMARK_GFM_EXPORT
+void cmark_html_buffer_reset(cmark_html_buffer *buffer);
+
+/** Frees 'buffer' and its memory.
+ */
+CMARK_GFM_EXPORT
+void cmark_html_buffer_free(cmark_html_buffer *buffer);
+
+/** A piece of the output of 'cmark_render_html_segments'.  It has the
+ * same members, in the same order, as POSIX 'struct iovec'.
+ */
+typedef struct cmark_html_segment {
+  const char *data;
+  size_t len;
+} cmark_html_segment;
+
+typedef struct cmark_html_segments cmark_html_segments;
+
+/** As for 'cmark_render_html', but produces the output as a list of
+ * segments to be written out in order, for example with 'writev'.
+ * Long stretches of the document that are output unchanged (text without
+ * characters to escape, code, and raw HTML with CMARK_OPT_UNSAFE) are not
+ * copied: their segments point into the nodes of 'root'.  The document
+ * must therefore be neither modified nor freed until the list has been
+ * freed with 'cmark_html_segments_free'.
+ */
+CMARK_GFM_EXPORT
+cmark_html_segments *cmark_render_html_segments(cmark_node *root, int options,
+                                                cmark_llist *extensions);
+
+/** Returns the segments in 'segments' and sets '*count' to their number.
+ */
+CMARK_GFM_EXPORT
+const cmark_html_segment *
+cmark_html_segments_get(const cmark_html_segments *segments, size_t *count);
+
+/** Returns the total length of the output in 'segments'.
+ */
+CMARK_GFM_EXPORT
+size_t cmark_html_segments_length(const cmark_html_segments *segments);
+
+/** Frees 'segments'.  The document they were rendered from may be
+ * modified or freed afterwards.
+ */
+CMARK_GFM_EXPORT
+void cmark_html_segments_free(cmark_html_segments *segments);
+
 /** Render a 'node' tree as a groff man page, without the header.
  * It is the caller's responsibility to free the returned buffer.
  */
@@ -650,6 +796,15 @@ char *cmark_render_man(cmark_node *root, int options, int width);
 CMARK_GFM_EXPORT
 char *cmark_render_man_with_mem(cmark_node *root, int options, int width, cmark_mem *mem);
 
+/** As for 'cmark_render_man', but passes the output to 'write' in
+ * pieces, as 'cmark_render_html_to_writer' does.  Only the current line
+ * is held back for wrapping, so memory use does not grow with the size of
+ * the output.
+ */
+CMARK_GFM_EXPORT
+int cmark_render_man_to_writer(cmark_node *root, int options, int width,
+                               cmark_write_func write, void *user_data);
+
 /** Render a 'node' tree as a commonmark document.
  * It is the caller's responsibility to free the returned buffer.
  */
@@ -662,6 +817,15 @@ char *cmark_render_commonmark(cmark_node *root, int options, int width);
 CMARK_GFM_EXPORT
 char *cmark_render_commonmark_with_mem(cmark_node *root, int options, int width, cmark_mem *mem);
 
+/** As for 'cmark_render_commonmark', but passes the output to 'write' in
+ * pieces, as 'cmark_render_html_to_writer' does.  Only the current line
+ * is held back for wrapping, so memory use does not grow with the size of
+ * the output.
+ */
+CMARK_GFM_EXPORT
+int cmark_render_commonmark_to_writer(cmark_node *root, int options, int width,
+                                      cmark_write_func write, void *user_data);
+
 /** Render a 'node' tree as a plain text document.
  * It is the caller's responsibility to free the returned buffer.
  */
@@ -674,6 +838,15 @@ char *cmark_render_plaintext(cmark_node *root, int options, int width);
 CMARK_GFM_EXPORT
 char *cmark_render_plaintext_with_mem(cmark_node *root, int options, int width, cmark_mem *mem);
 
+/** As for 'cmark_render_plaintext', but passes the output to 'write' in
+ * pieces, as 'cmark_render_html_to_writer' does.  Only the current line
+ * is held back for wrapping, so memory use does not grow with the size of
+ * the output.
+ */
+CMARK_GFM_EXPORT
+int cmark_render_plaintext_to_writer(cmark_node *root, int options, int width,
+                                     cmark_write_func write, void *user_data);
+
 /** Render a 'node' tree as a LaTeX document.
  * It is the caller's responsibility to free the returned buffer.
  */
@@ -686,6 +859,15 @@ char *cmark_render_latex(cmark_node *root, int options, int width);
 CMARK_GFM_EXPORT
 char *cmark_render_latex_with_mem(cmark_node *root, int options, int width, cmark_mem *mem);
 
+/** As for 'cmark_render_latex', but passes the output to 'write' in
+ * pieces, as 'cmark_render_html_to_writer' does.  Only the current line
+ * is held back for wrapping, so memory use does not grow with the size of
+ * the output.
+ */
+CMARK_GFM_EXPORT
+int cmark_render_latex_to_writer(cmark_node *root, int options, int width,
+                                 cmark_write_func write, void *user_data);
+
 /**
  * ## Options
  */
@@ -14,6 +14,9 @@
 #include "syntax_extension.h"
 
 #define OUT(s, wrap, escaping) renderer->out(renderer, node, s, wrap, escaping)
+#define OUT_CHUNK(c, wrap, escaping)                                           \
+  renderer->out_len(renderer, node, (const char *)(c)->data, (c)->len, wrap,   \
+                    escaping)
 #define LIT(s) renderer->out(renderer, node, s, false, LITERAL)
 #define CR() renderer->cr(renderer)
 #define BLANKLINE() renderer->blankline(renderer)
@@ -153,6 +156,21 @@ static bool is_autolink(cmark_node *node) {
                   link_text->as.literal.len) == 0);
 }
 
+// The bytes outc writes out unchanged, for cmark_render: printable ASCII
+// except *_[]#<>\`~!&.
+static const uint8_t SAFE_CHARS[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 0,
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
 static int S_render_node(cmark_renderer *renderer, cmark_node *node,
                          cmark_event_type ev_type, int options) {
   int list_number;
@@ -285,7 +303,7 @@ static int S_render_node(cmark_renderer *renderer, cmark_node *node,
         !first_in_list_item) {
       LIT("    ");
       cmark_strbuf_puts(renderer->prefix, "    ");
-      OUT(cmark_node_get_literal(node), false, LITERAL);
+      OUT_CHUNK(&node->as.code.literal, false, LITERAL);
       cmark_strbuf_truncate(renderer->prefix, renderer->prefix->size - 4);
     } else {
       numticks = longest_backtick_sequence(code) + 1;
@@ -298,7 +316,7 @@ static int S_render_node(cmark_renderer *renderer, cmark_node *node,
       LIT(" ");
       OUT(info, false, LITERAL);
       CR();
-      OUT(cmark_node_get_literal(node), false, LITERAL);
+      OUT_CHUNK(&node->as.code.literal, false, LITERAL);
       CR();
       for (i = 0; i < numticks; i++) {
         LIT(fencechar);
@@ -309,7 +327,7 @@ static int S_render_node(cmark_renderer *renderer, cmark_node *node,
 
   case CMARK_NODE_HTML_BLOCK:
     BLANKLINE();
-    OUT(cmark_node_get_literal(node), false, LITERAL);
+    OUT_CHUNK(&node->as.literal, false, LITERAL);
     BLANKLINE();
     break;
 
@@ -333,7 +351,7 @@ static int S_render_node(cmark_renderer *renderer, cmark_node *node,
     break;
 
   case CMARK_NODE_TEXT:
-    OUT(cmark_node_get_literal(node), allow_wrap, NORMAL);
+    OUT_CHUNK(&node->as.literal, allow_wrap, NORMAL);
     break;
 
   case CMARK_NODE_LINEBREAK:
@@ -369,7 +387,7 @@ static int S_render_node(cmark_renderer *renderer, cmark_node *node,
     if (extra_spaces) {
       LIT(" ");
     }
-    OUT(cmark_node_get_literal(node), allow_wrap, LITERAL);
+    OUT_CHUNK(&node->as.literal, allow_wrap, LITERAL);
     if (extra_spaces) {
       LIT(" ");
     }
@@ -379,7 +397,7 @@ static int S_render_node(cmark_renderer *renderer, cmark_node *node,
     break;
 
   case CMARK_NODE_HTML_INLINE:
-    OUT(cmark_node_get_literal(node), false, LITERAL);
+    OUT_CHUNK(&node->as.literal, false, LITERAL);
     break;
 
   case CMARK_NODE_CUSTOM_INLINE:
@@ -510,5 +528,16 @@ char *cmark_render_commonmark_with_mem(cmark_node *root, int options, int width,
     // a different meaning with OPT_HARDBREAKS
     width = 0;
   }
-  return cmark_render(mem, root, options, width, outc, S_render_node);
+  return cmark_render(mem, root, options, width, outc, SAFE_CHARS,
+                      S_render_node);
+}
+
+int cmark_render_commonmark_to_writer(cmark_node *root, int options, int width,
+                                      cmark_write_func write, void *user_data) {
+  if (options & CMARK_OPT_HARDBREAKS) {
+    // see cmark_render_commonmark_with_mem
+    width = 0;
+  }
+  return cmark_render_to_writer(root, options, width, outc, SAFE_CHARS,
+                                S_render_node, write, user_data);
 }
@@ -23,16 +23,11 @@ void cmark_footnote_create(cmark_map *map, cmark_node *node) {
   if (reflabel == NULL)
     return;
 
-  assert(map->sorted == NULL);
-
   ref = (cmark_footnote *)map->mem->calloc(1, sizeof(*ref));
   ref->entry.label = reflabel;
   ref->node = node;
-  ref->entry.age = map->size;
-  ref->entry.next = map->refs;
 
-  map->refs = (cmark_map_entry *)ref;
-  map->size++;
+  cmark_map_add(map, &ref->entry);
 }
 
 cmark_map *cmark_footnote_map_new(cmark_mem *mem) {
@@ -31,6 +31,63 @@ extern "C" {
 #define HOUDINI_ESCAPED_SIZE(x) (((x)*12) / 10)
 #define HOUDINI_UNESCAPED_SIZE(x) (x)
 
+/*
+ * A set of bytes for houdini_scan, in two equivalent forms.  The SIMD
+ * scanners use the nibble bitmap: byte 'c' below 0x80 is in the set if bit
+ * 'c >> 4' of 'lo[c & 15]' is set, and all bytes from 0x80 up are in the
+ * set if 'high' is 0x80 and none are if it is 0.  The scalar scanner uses
+ * the escaper's own table: 'c' is in the set if 'table[c] - first' is below
+ * 'count'.
+ * */
+typedef struct {
+  uint8_t lo[16];
+  uint8_t high;
+  const char *table;
+  uint8_t first;
+  uint8_t count;
+} houdini_byte_class;
+
+typedef enum {
+  HOUDINI_SCAN_AUTO,
+  HOUDINI_SCAN_SCALAR,
+  HOUDINI_SCAN_SSSE3,
+  HOUDINI_SCAN_AVX2
+} houdini_scan_impl;
+
+
+/* Forces the scanner used by the escaping functions; HOUDINI_SCAN_AUTO
+ * picks the fastest one the CPU supports, which is also what happens on
+ * first use.  Returns 0 if 'impl' is not available on this build or CPU.
+ * This is meant for tests and benchmarks and is not thread-safe. */
+CMARK_GFM_EXPORT
+int houdini_set_scan_impl(houdini_scan_impl impl);
+
+CMARK_GFM_EXPORT
+houdini_scan_impl houdini_get_scan_impl(void);
+
+bufsize_t houdini_scan_dispatch(const houdini_byte_class *cls,
+                                const uint8_t *src, bufsize_t i,
+                                bufsize_t size);
+
+/* Returns the offset of the first byte in 'src[i..size)' that belongs to
+ * 'cls', or 'size' if there is none.  Runs shorter than a SIMD block are
+ * scanned in place rather than through the dispatched kernel. */
+static CMARK_INLINE bufsize_t houdini_scan(const houdini_byte_class *cls,
+                                           const uint8_t *src, bufsize_t i,
+                                           bufsize_t size) {
+  if (size - i >= 16)
+    return houdini_scan_dispatch(cls, src, i, size);
+  while (i < size && (uint8_t)(cls->table[src[i]] - cls->first) >= cls->count)
+    i++;
+  return i;
+}
+
+/* Makes room for 'add' more bytes plus the terminating NUL in 'ob'. */
+static CMARK_INLINE void houdini_reserve(cmark_strbuf *ob, bufsize_t add) {
+  if (ob->size + add >= ob->asize)
+    cmark_strbuf_grow(ob, ob->size + add);
+}
+
 CMARK_GFM_EXPORT
 bufsize_t houdini_unescape_ent(cmark_strbuf *ob, const uint8_t *src,
                                       bufsize_t size);
@@ -40,6 +97,10 @@ int houdini_escape_html(cmark_strbuf *ob, const uint8_t *src,
 CMARK_GFM_EXPORT
 int houdini_escape_html0(cmark_strbuf *ob, const uint8_t *src,
                                 bufsize_t size, int secure);
+/* The length of the prefix of 'src' that houdini_escape_html0 copies
+ * unchanged when not in secure mode. */
+CMARK_GFM_EXPORT
+bufsize_t houdini_html_clean_len(const uint8_t *src, bufsize_t size);
 CMARK_GFM_EXPORT
 int houdini_unescape_html(cmark_strbuf *ob, const uint8_t *src,
                                  bufsize_t size);
@@ -43,37 +43,51 @@ static const char HREF_SAFE[] = {
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 };
 
+/* The bytes that are not in HREF_SAFE: the control characters, space,
+ * "&'<>[\]^`{|}, DEL, and all bytes from 0x80 up. */
+static const houdini_byte_class HREF_UNSAFE_CLASS = {
+    {0x47, 0x03, 0x07, 0x03, 0x03, 0x03, 0x07, 0x07, 0x03, 0x03, 0x03, 0xa3,
+     0xab, 0xa3, 0x2b, 0x83},
+    0x80, HREF_SAFE, 0, 1};
+
+#define HREF_ESCAPE_MAX 6
+
 int houdini_escape_href(cmark_strbuf *ob, const uint8_t *src, bufsize_t size) {
   static const uint8_t hex_chars[] = "0123456789ABCDEF";
   bufsize_t i = 0, org;
-  uint8_t hex_str[3];
+  uint8_t *out;
 
-  hex_str[0] = '%';
+  if (size == 0)
+    return 1;
 
   while (i < size) {
     org = i;
-    while (i < size && HREF_SAFE[src[i]] != 0)
-      i++;
+    i = houdini_scan(&HREF_UNSAFE_CLASS, src, i, size);
 
-    if (likely(i > org))
-      cmark_strbuf_put(ob, src + org, i - org);
+    /* one reservation covers the clean run and the escape ending it */
+    houdini_reserve(ob, i - org + HREF_ESCAPE_MAX);
+    memcpy(ob->ptr + ob->size, src + org, i - org);
+    ob->size += i - org;
 
     /* escaping */
     if (i >= size)
       break;
 
+    out = ob->ptr + ob->size;
     switch (src[i]) {
     /* amp appears all the time in URLs, but needs
      * HTML-entity escaping to be inside an href */
     case '&':
-      cmark_strbuf_puts(ob, "&amp;");
+      memcpy(out, "&amp;", 5);
+      ob->size += 5;
       break;
 
     /* the single quote is a valid URL character
      * according to the standard; it needs HTML
      * entity escaping too */
     case '\'':
-      cmark_strbuf_puts(ob, "&#x27;");
+      memcpy(out, "&#x27;", 6);
+      ob->size += 6;
       break;
 
 /* the space can be escaped to %20 or a plus
@@ -82,19 +96,22 @@ int houdini_escape_href(cmark_strbuf *ob, const uint8_t *src, bufsize_t size) {
  * when building GET strings */
 #if 0
 		case ' ':
-			cmark_strbuf_putc(ob, '+');
+			*out = '+';
+			ob->size += 1;
 			break;
 #endif
 
     /* every other character goes with a %XX escaping */
     default:
-      hex_str[1] = hex_chars[(src[i] >> 4) & 0xF];
-      hex_str[2] = hex_chars[src[i] & 0xF];
-      cmark_strbuf_put(ob, hex_str, 3);
+      out[0] = '%';
+      out[1] = hex_chars[(src[i] >> 4) & 0xF];
+      out[2] = hex_chars[src[i] & 0xF];
+      ob->size += 3;
     }
 
     i++;
   }
 
+  ob->ptr[ob->size] = '\0';
   return 1;
 }
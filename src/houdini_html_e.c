@@ -17,8 +17,8 @@
  */
 static const char HTML_ESCAPE_TABLE[] = {
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 2, 3, 0, 0, 0, 0, 0, 0, 0, 4,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 2, 5, 0, 0, 0, 0, 0, 0, 0, 6,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0,
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -29,38 +29,62 @@ static const char HTML_ESCAPE_TABLE[] = {
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 };
 
-static const char *HTML_ESCAPES[] = {"",      "&quot;", "&amp;", "&#39;",
-                                     "&#47;", "&lt;",   "&gt;"};
+static const struct {
+  const char *str;
+  bufsize_t len;
+} HTML_ESCAPES[] = {{"", 0},      {"&quot;", 6}, {"&amp;", 5}, {"&lt;", 4},
+                    {"&gt;", 4},  {"&#39;", 5},  {"&#47;", 5}};
+
+#define HTML_ESCAPE_MAX 6
+
+/* The bytes in HTML_ESCAPE_TABLE, and the same without the forward slash
+ * and single quote, which are only escaped in secure mode and so come last
+ * in HTML_ESCAPES. */
+static const houdini_byte_class HTML_SECURE_CLASS = {
+    {0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00,
+     0x08, 0x00, 0x08, 0x04},
+    0, HTML_ESCAPE_TABLE, 1, 6};
+static const houdini_byte_class HTML_CLASS = {
+    {0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x08, 0x00, 0x08, 0x00},
+    0, HTML_ESCAPE_TABLE, 1, 4};
 
 int houdini_escape_html0(cmark_strbuf *ob, const uint8_t *src, bufsize_t size,
                          int secure) {
-  bufsize_t i = 0, org, esc = 0;
+  const houdini_byte_class *cls = secure ? &HTML_SECURE_CLASS : &HTML_CLASS;
+  bufsize_t i = 0, org, esc;
+
+  if (size == 0)
+    return 1;
 
   while (i < size) {
     org = i;
-    while (i < size && (esc = HTML_ESCAPE_TABLE[src[i]]) == 0)
-      i++;
+    i = houdini_scan(cls, src, i, size);
 
-    if (i > org)
-      cmark_strbuf_put(ob, src + org, i - org);
+    /* one reservation covers the clean run and the escape ending it */
+    houdini_reserve(ob, i - org + HTML_ESCAPE_MAX);
+    memcpy(ob->ptr + ob->size, src + org, i - org);
+    ob->size += i - org;
 
     /* escaping */
     if (unlikely(i >= size))
       break;
 
-    /* The forward slash and single quote are only escaped in secure mode */
-    if ((src[i] == '/' || src[i] == '\'') && !secure) {
-      cmark_strbuf_putc(ob, src[i]);
-    } else {
-      cmark_strbuf_puts(ob, HTML_ESCAPES[esc]);
-    }
+    esc = HTML_ESCAPE_TABLE[src[i]];
+    memcpy(ob->ptr + ob->size, HTML_ESCAPES[esc].str, HTML_ESCAPES[esc].len);
+    ob->size += HTML_ESCAPES[esc].len;
 
     i++;
   }
 
+  ob->ptr[ob->size] = '\0';
   return 1;
 }
 
+bufsize_t houdini_html_clean_len(const uint8_t *src, bufsize_t size) {
+  return houdini_scan(&HTML_CLASS, src, 0, size);
+}
+
 int houdini_escape_html(cmark_strbuf *ob, const uint8_t *src, bufsize_t size) {
   return houdini_escape_html0(ob, src, size, 1);
 }
@@ -7,32 +7,34 @@
 #include "utf8.h"
 #include "entities.inc"
 
-/* Binary tree lookup code for entities added by JGM */
-
-static const unsigned char *S_lookup(int i, int low, int hi,
-                                     const unsigned char *s, int len) {
-  int j;
-  int cmp =
-      strncmp((const char *)s, (const char *)cmark_entities[i].entity, len);
-  if (cmp == 0 && cmark_entities[i].entity[len] == 0) {
-    return (const unsigned char *)cmark_entities[i].bytes;
-  } else if (cmp <= 0 && i > low) {
-    j = i - ((i - low) / 2);
-    if (j == i)
-      j -= 1;
-    return S_lookup(j, low, i - 1, s, len);
-  } else if (cmp > 0 && i < hi) {
-    j = i + ((hi - i) / 2);
-    if (j == i)
-      j += 1;
-    return S_lookup(j, i + 1, hi, s, len);
-  } else {
-    return NULL;
+/* Minimal perfect hash lookup for entities; the tables are generated by
+ * tools/make_entities_inc.py, which must use the same hash function. */
+
+static CMARK_INLINE uint32_t S_entity_hash(const unsigned char *s, int len,
+                                           uint32_t seed) {
+  uint32_t h = 2166136261u ^ seed;
+  int i;
+
+  for (i = 0; i < len; ++i) {
+    h ^= s[i];
+    h *= 16777619u;
   }
+
+  return h;
 }
 
 static const unsigned char *S_lookup_entity(const unsigned char *s, int len) {
-  return S_lookup(CMARK_NUM_ENTITIES / 2, 0, CMARK_NUM_ENTITIES - 1, s, len);
+  int32_t d = cmark_entity_displacements[S_entity_hash(s, len, 0) %
+                                         CMARK_ENTITY_NUM_BUCKETS];
+  uint32_t slot = d < 0 ? (uint32_t)(-d - 1)
+                        : S_entity_hash(s, len, (uint32_t)d) % CMARK_NUM_ENTITIES;
+  const struct cmark_entity_node *node = &cmark_entities[slot];
+
+  if (strncmp((const char *)s, (const char *)node->entity, len) == 0 &&
+      node->entity[len] == 0)
+    return (const unsigned char *)node->bytes;
+
+  return NULL;
 }
 
 bufsize_t houdini_unescape_ent(cmark_strbuf *ob, const uint8_t *src,
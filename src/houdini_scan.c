@@ -0,0 +1,188 @@
+#include "houdini.h"
+
+/* Scanners for the next byte that needs escaping.
+ *
+ * A byte class is described by a bitmap indexed by the low nibble, with one
+ * bit per high nibble 0-7, plus a flag for all bytes from 0x80 up.  The SIMD
+ * kernels look both nibbles up with a byte shuffle, which classifies 16 or
+ * 32 bytes with a handful of instructions; the scalar kernel looks each
+ * byte up in the escaper's table instead.
+ *
+ * The kernel is picked on first use from the features the CPU reports, and
+ * can be forced with houdini_set_scan_impl() for testing. */
+
+#ifdef HAVE_X86_SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
+static CMARK_INLINE bool S_in_class(const houdini_byte_class *cls,
+                                    uint8_t c) {
+  return (uint8_t)(cls->table[c] - cls->first) < cls->count;
+}
+
+static bufsize_t S_scan_scalar(const houdini_byte_class *cls,
+                               const uint8_t *src, bufsize_t i,
+                               bufsize_t size) {
+  while (i < size && !S_in_class(cls, src[i]))
+    i++;
+  return i;
+}
+
+#ifdef HAVE_X86_SIMD_DISPATCH
+
+// Bit 'n' is set in the result if byte 'n' of 'v' belongs to the class.
+__attribute__((target("ssse3"))) static CMARK_INLINE unsigned
+S_class_mask16(__m128i v, __m128i lo_bits, __m128i high) {
+  const __m128i hi_bits =
+      _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  __m128i lo = _mm_shuffle_epi8(lo_bits, _mm_and_si128(v, nibble));
+  __m128i hi = _mm_shuffle_epi8(hi_bits,
+                                _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+  unsigned clean = (unsigned)_mm_movemask_epi8(
+      _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128()));
+
+  return (~clean & 0xFFFF) |
+         (unsigned)_mm_movemask_epi8(_mm_and_si128(v, high));
+}
+
+__attribute__((target("ssse3"))) static bufsize_t
+S_scan_ssse3(const houdini_byte_class *cls, const uint8_t *src, bufsize_t i,
+             bufsize_t size) {
+  const __m128i lo_bits = _mm_loadu_si128((const __m128i *)cls->lo);
+  const __m128i high = _mm_set1_epi8((char)cls->high);
+  unsigned mask;
+
+  for (; size - i >= 16; i += 16) {
+    mask = S_class_mask16(_mm_loadu_si128((const __m128i *)(src + i)),
+                          lo_bits, high);
+    if (mask)
+      return i + __builtin_ctz(mask);
+  }
+
+  return S_scan_scalar(cls, src, i, size);
+}
+
+__attribute__((target("avx2"))) static bufsize_t
+S_scan_avx2(const houdini_byte_class *cls, const uint8_t *src, bufsize_t i,
+            bufsize_t size) {
+  const __m128i lo_bits = _mm_loadu_si128((const __m128i *)cls->lo);
+  const __m128i high = _mm_set1_epi8((char)cls->high);
+  unsigned mask;
+
+  if (size - i >= 32) {
+    const __m256i lo_bits2 = _mm256_broadcastsi128_si256(lo_bits);
+    const __m256i hi_bits2 = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8,
+        16, 32, 64, (char)128, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i high2 = _mm256_broadcastsi128_si256(high);
+
+    for (; size - i >= 32; i += 32) {
+      __m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+      __m256i lo = _mm256_shuffle_epi8(lo_bits2, _mm256_and_si256(v, nibble));
+      __m256i hi = _mm256_shuffle_epi8(
+          hi_bits2, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+
+      mask = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                 _mm256_and_si256(lo, hi), _mm256_setzero_si256())) |
+             (unsigned)_mm256_movemask_epi8(_mm256_and_si256(v, high2));
+      if (mask) {
+        _mm256_zeroupper();
+        return i + __builtin_ctz(mask);
+      }
+    }
+
+    // Leave no dirty upper halves behind for SSE code in the caller.
+    _mm256_zeroupper();
+  }
+
+  if (size - i >= 16) {
+    mask = S_class_mask16(_mm_loadu_si128((const __m128i *)(src + i)),
+                          lo_bits, high);
+    if (mask)
+      return i + __builtin_ctz(mask);
+    i += 16;
+  }
+
+  return S_scan_scalar(cls, src, i, size);
+}
+
+#endif
+
+typedef bufsize_t (*houdini_scan_func)(const houdini_byte_class *,
+                                       const uint8_t *, bufsize_t, bufsize_t);
+
+static houdini_scan_impl S_impl = HOUDINI_SCAN_AUTO;
+static houdini_scan_func S_scan = NULL;
+
+static bool S_impl_supported(houdini_scan_impl impl) {
+  switch (impl) {
+  case HOUDINI_SCAN_SCALAR:
+    return true;
+#ifdef HAVE_X86_SIMD_DISPATCH
+  case HOUDINI_SCAN_SSSE3:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+  case HOUDINI_SCAN_AVX2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+  default:
+    return false;
+  }
+}
+
+static void S_use_impl(houdini_scan_impl impl) {
+  switch (impl) {
+#ifdef HAVE_X86_SIMD_DISPATCH
+  case HOUDINI_SCAN_SSSE3:
+    S_scan = S_scan_ssse3;
+    break;
+  case HOUDINI_SCAN_AVX2:
+    S_scan = S_scan_avx2;
+    break;
+#endif
+  default:
+    impl = HOUDINI_SCAN_SCALAR;
+    S_scan = S_scan_scalar;
+    break;
+  }
+  S_impl = impl;
+}
+
+static void S_detect_impl(void) {
+  if (S_impl_supported(HOUDINI_SCAN_AVX2))
+    S_use_impl(HOUDINI_SCAN_AVX2);
+  else if (S_impl_supported(HOUDINI_SCAN_SSSE3))
+    S_use_impl(HOUDINI_SCAN_SSSE3);
+  else
+    S_use_impl(HOUDINI_SCAN_SCALAR);
+}
+
+int houdini_set_scan_impl(houdini_scan_impl impl) {
+  if (impl == HOUDINI_SCAN_AUTO) {
+    S_detect_impl();
+    return 1;
+  }
+  if (!S_impl_supported(impl))
+    return 0;
+  S_use_impl(impl);
+  return 1;
+}
+
+houdini_scan_impl houdini_get_scan_impl(void) {
+  if (S_scan == NULL)
+    S_detect_impl();
+  return S_impl;
+}
+
+bufsize_t houdini_scan_dispatch(const houdini_byte_class *cls,
+                                const uint8_t *src, bufsize_t i,
+                                bufsize_t size) {
+  // Detection is idempotent, so threads racing through it on first use
+  // all store the same kernel.
+  if (unlikely(S_scan == NULL))
+    S_detect_impl();
+  return S_scan(cls, src, i, size);
+}
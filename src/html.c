@@ -9,6 +9,7 @@
 #include "scanners.h"
 #include "syntax_extension.h"
 #include "html.h"
+#include "iterator.h"
 #include "render.h"
 
 // Functions to convert cmark_nodes to HTML strings.
@@ -18,45 +19,297 @@ static void escape_html(cmark_strbuf *dest, const unsigned char *source,
   houdini_escape_html0(dest, source, length, 0);
 }
 
-static void filter_html_block(cmark_html_renderer *renderer, uint8_t *data, size_t len) {
-  cmark_strbuf *html = renderer->html;
-  cmark_llist *it;
-  cmark_syntax_extension *ext;
-  bool filtered;
-  uint8_t *match;
+// The contents of a buffer for cmark_render_html_to_buffer.
+struct cmark_html_buffer {
+  cmark_strbuf html;
+};
+
+// Segmented output.
+//
+// cmark_render_html_segments renders into a buffer as usual, except that
+// runs of source text of at least HTML_SEGMENT_MIN bytes that are output
+// unchanged are only recorded, together with the buffer offset they go
+// at.  The segment list is put together from both once rendering is done.
+
+#define HTML_SEGMENT_MIN 64
+
+typedef struct {
+  const unsigned char *data;
+  bufsize_t len;
+  bufsize_t at;
+} html_ref;
+
+struct cmark_html_segments {
+  cmark_mem *mem;
+  cmark_strbuf html;
+  html_ref *refs;
+  bufsize_t nrefs;
+  bufsize_t refs_size;
+  cmark_html_segment *items;
+  size_t count;
+  size_t length;
+};
+
+static void S_add_ref(cmark_html_segments *segments,
+                      const unsigned char *data, bufsize_t len) {
+  html_ref *ref;
+
+  if (segments->nrefs == segments->refs_size) {
+    segments->refs_size = segments->refs_size ? segments->refs_size * 2 : 16;
+    segments->refs = (html_ref *)segments->mem->realloc(
+        segments->refs, segments->refs_size * sizeof(html_ref));
+  }
+  ref = &segments->refs[segments->nrefs++];
+  ref->data = data;
+  ref->len = len;
+  ref->at = segments->html.size;
+}
+
+// Outputs source text that needs no escaping.  A referenced run still has
+// its last byte copied, so that the buffer always ends in the last byte
+// of output, which cmark_html_render_cr looks at.
+static CMARK_INLINE void S_put_verbatim(cmark_html_renderer *renderer,
+                                        const unsigned char *data,
+                                        bufsize_t len) {
+  if (renderer->segments && len >= HTML_SEGMENT_MIN) {
+    S_add_ref(renderer->segments, data, len - 1);
+    data += len - 1;
+    len = 1;
+  }
+  cmark_strbuf_put(renderer->html, data, len);
+}
+
+// As for escape_html, but referencing long clean runs when collecting
+// segments.
+static void S_escape(cmark_html_renderer *renderer, const unsigned char *data,
+                     bufsize_t len) {
+  bufsize_t run;
+
+  if (!renderer->segments || len < HTML_SEGMENT_MIN) {
+    escape_html(renderer->html, data, len);
+    return;
+  }
 
-  while (len) {
-    match = (uint8_t *) memchr(data, '<', len);
-    if (!match)
+  while (len > 0) {
+    run = houdini_html_clean_len(data, len);
+    S_put_verbatim(renderer, data, run);
+    if (run == len)
       break;
+    escape_html(renderer->html, data + run, 1);
+    data += run + 1;
+    len -= run + 1;
+  }
+}
 
-    if (match != data) {
-      cmark_strbuf_put(html, data, (bufsize_t)(match - data));
-      len -= (match - data);
-      data = match;
+// The number of bytes of the 'len'-byte literal at 'data' that fit in what
+// is left of an excerpt's budget once 'escaped', cut at a character
+// boundary.  If that is not all of them, rendering stops after the current
+// node.
+static bufsize_t S_fit_literal(cmark_html_renderer *renderer,
+                               const unsigned char *data, bufsize_t len,
+                               bool escaped) {
+  size_t used = (size_t)renderer->html->size;
+  size_t left, cost = 0, n;
+  bufsize_t fit = 0;
+
+  if (!renderer->max_len)
+    return len;
+  left = used < renderer->max_len ? renderer->max_len - used : 0;
+
+  if (!escaped) {
+    if ((size_t)len <= left)
+      return len;
+    fit = (bufsize_t)left;
+  } else if ((size_t)len <= left / 6) {
+    // No byte is longer than "&quot;" once escaped.
+    return len;
+  } else {
+    for (; fit < len; fit++, cost += n) {
+      switch (data[fit]) {
+      case '"':
+        n = 6;
+        break;
+      case '&':
+        n = 5;
+        break;
+      case '<':
+      case '>':
+        n = 4;
+        break;
+      default:
+        n = 1;
+      }
+      if (cost + n > left)
+        break;
     }
+    if (fit == len)
+      return len;
+  }
 
-    filtered = false;
-    for (it = renderer->filter_extensions; it; it = it->next) {
-      ext = ((cmark_syntax_extension *) it->data);
-      if (!ext->html_filter_func(ext, data, len)) {
-        filtered = true;
-        break;
+  renderer->stopped = true;
+  while (fit > 0 && (data[fit] & 0xC0) == 0x80)
+    fit--;
+  return fit;
+}
+
+// Copies a literal the parser found nothing to escape in as it is.
+static CMARK_INLINE void escape_literal(cmark_html_renderer *renderer,
+                                        const cmark_chunk *literal) {
+  bool escaped = !(literal->flags & CMARK_CHUNK_NO_HTML_SPECIAL);
+  bufsize_t len = S_fit_literal(renderer, literal->data, literal->len, escaped);
+
+  if (escaped)
+    S_escape(renderer, literal->data, len);
+  else
+    S_put_verbatim(renderer, literal->data, len);
+}
+
+// Raw HTML tag filtering.
+//
+// The tag names registered by filter extensions are compiled into a trie
+// over case-folded tag name bytes the first time raw HTML is rendered.
+// Extensions that only provide an html_filter_func are still called for
+// every '<'.
+
+#define TAG_MATCHER_SLOTS 37
+
+typedef struct {
+  int next[TAG_MATCHER_SLOTS];
+  bool terminal;
+} tag_matcher_node;
+
+struct cmark_html_tag_matcher {
+  tag_matcher_node *nodes;
+  int size;
+  int asize;
+};
+
+static int S_tag_slot(unsigned char c) {
+  if (c >= 'a' && c <= 'z')
+    return c - 'a';
+  if (c >= 'A' && c <= 'Z')
+    return c - 'A';
+  if (c >= '0' && c <= '9')
+    return 26 + c - '0';
+  if (c == '-')
+    return 36;
+  return -1;
+}
+
+static int S_tag_matcher_add_node(cmark_mem *mem,
+                                  struct cmark_html_tag_matcher *matcher) {
+  if (matcher->size == matcher->asize) {
+    matcher->asize = matcher->asize ? matcher->asize * 2 : 32;
+    matcher->nodes = (tag_matcher_node *)mem->realloc(
+        matcher->nodes, matcher->asize * sizeof(tag_matcher_node));
+  }
+  memset(&matcher->nodes[matcher->size], 0, sizeof(tag_matcher_node));
+  return matcher->size++;
+}
+
+static struct cmark_html_tag_matcher *
+S_tag_matcher_new(cmark_mem *mem, cmark_llist *extensions) {
+  struct cmark_html_tag_matcher *matcher =
+      (struct cmark_html_tag_matcher *)mem->calloc(1, sizeof(*matcher));
+  cmark_llist *tags;
+  const unsigned char *c;
+  int node, slot;
+
+  S_tag_matcher_add_node(mem, matcher);
+
+  for (; extensions; extensions = extensions->next) {
+    tags = ((cmark_syntax_extension *)extensions->data)->html_filter_tags;
+    for (; tags; tags = tags->next) {
+      node = 0;
+      for (c = (const unsigned char *)tags->data; *c; ++c) {
+        slot = S_tag_slot(*c);
+        if (!matcher->nodes[node].next[slot]) {
+          int child = S_tag_matcher_add_node(mem, matcher);
+          matcher->nodes[node].next[slot] = child;
+        }
+        node = matcher->nodes[node].next[slot];
       }
+      matcher->nodes[node].terminal = true;
     }
+  }
 
-    if (!filtered) {
-      cmark_strbuf_putc(html, '<');
-    } else {
+  return matcher;
+}
+
+static void S_tag_matcher_free(cmark_mem *mem,
+                               struct cmark_html_tag_matcher *matcher) {
+  if (!matcher)
+    return;
+  mem->free(matcher->nodes);
+  mem->free(matcher);
+}
+
+// Returns true if 'data' starts with an opening or closing tag whose name
+// is in 'matcher'.
+static bool S_tag_matcher_match(const struct cmark_html_tag_matcher *matcher,
+                                const uint8_t *data, size_t len) {
+  size_t i = 1;
+  int node = 0, slot;
+
+  if (i < len && data[i] == '/')
+    ++i;
+
+  for (; i < len; ++i) {
+    slot = S_tag_slot(data[i]);
+    if (slot < 0)
+      break;
+    node = matcher->nodes[node].next[slot];
+    if (!node)
+      return false;
+  }
+
+  if (i == len || !matcher->nodes[node].terminal)
+    return false;
+
+  return cmark_isspace(data[i]) || data[i] == '>' ||
+         (data[i] == '/' && i + 1 < len && data[i + 1] == '>');
+}
+
+static bool S_has_html_filters(cmark_html_renderer *renderer) {
+  if (renderer->filter_tag_extensions && !renderer->tag_matcher)
+    renderer->tag_matcher = S_tag_matcher_new(renderer->html->mem,
+                                              renderer->filter_tag_extensions);
+  return renderer->tag_matcher || renderer->filter_extensions;
+}
+
+static bool S_html_filtered(cmark_html_renderer *renderer, const uint8_t *data,
+                            size_t len) {
+  cmark_llist *it;
+  cmark_syntax_extension *ext;
+
+  if (renderer->tag_matcher &&
+      S_tag_matcher_match(renderer->tag_matcher, data, len))
+    return true;
+
+  for (it = renderer->filter_extensions; it; it = it->next) {
+    ext = (cmark_syntax_extension *)it->data;
+    if (!ext->html_filter_func(ext, data, len))
+      return true;
+  }
+
+  return false;
+}
+
+static void filter_html_block(cmark_html_renderer *renderer, uint8_t *data, size_t len) {
+  cmark_strbuf *html = renderer->html;
+  uint8_t *end = data + len;
+  uint8_t *match = data;
+
+  while ((match = (uint8_t *) memchr(match, '<', end - match)) != NULL) {
+    if (S_html_filtered(renderer, match, end - match)) {
+      S_put_verbatim(renderer, data, (bufsize_t)(match - data));
       cmark_strbuf_puts(html, "&lt;");
+      data = match + 1;
     }
-
-    ++data;
-    --len;
+    ++match;
   }
 
-  if (len)
-    cmark_strbuf_put(html, data, (bufsize_t)len);
+  S_put_verbatim(renderer, data, (bufsize_t)(end - data));
 }
 
 static bool S_put_footnote_backref(cmark_html_renderer *renderer, cmark_strbuf *html, cmark_node *node) {
@@ -106,12 +359,9 @@ static int S_render_node(cmark_html_renderer *renderer, cmark_node *node,
   cmark_node *parent;
   cmark_node *grandparent;
   cmark_strbuf *html = renderer->html;
-  cmark_llist *it;
-  cmark_syntax_extension *ext;
   char start_heading[] = "<h0";
   char end_heading[] = "</h0";
   bool tight;
-  bool filtered;
   char buffer[BUFFER_SIZE];
 
   bool entering = (ev_type == CMARK_EVENT_ENTER);
@@ -125,7 +375,7 @@ static int S_render_node(cmark_html_renderer *renderer, cmark_node *node,
     case CMARK_NODE_TEXT:
     case CMARK_NODE_CODE:
     case CMARK_NODE_HTML_INLINE:
-      escape_html(html, node->as.literal.data, node->as.literal.len);
+      escape_literal(renderer, &node->as.literal);
       break;
 
     case CMARK_NODE_LINEBREAK:
@@ -249,7 +499,9 @@ static int S_render_node(cmark_html_renderer *renderer, cmark_node *node,
       }
     }
 
-    escape_html(html, node->as.code.literal.data, node->as.code.literal.len);
+    S_escape(renderer, node->as.code.literal.data,
+             S_fit_literal(renderer, node->as.code.literal.data,
+                           node->as.code.literal.len, true));
     cmark_strbuf_puts(html, "</code></pre>\n");
     break;
 
@@ -257,10 +509,14 @@ static int S_render_node(cmark_html_renderer *renderer, cmark_node *node,
     cmark_html_render_cr(html);
     if (!(options & CMARK_OPT_UNSAFE)) {
       cmark_strbuf_puts(html, "<!-- raw HTML omitted -->");
-    } else if (renderer->filter_extensions) {
+    } else if (S_fit_literal(renderer, node->as.literal.data,
+                             node->as.literal.len, false) <
+               node->as.literal.len) {
+      // Raw HTML over an excerpt's budget is left out rather than cut.
+    } else if (S_has_html_filters(renderer)) {
       filter_html_block(renderer, node->as.literal.data, node->as.literal.len);
     } else {
-      cmark_strbuf_put(html, node->as.literal.data, node->as.literal.len);
+      S_put_verbatim(renderer, node->as.literal.data, node->as.literal.len);
     }
     cmark_html_render_cr(html);
     break;
@@ -309,7 +565,7 @@ static int S_render_node(cmark_html_renderer *renderer, cmark_node *node,
     break;
 
   case CMARK_NODE_TEXT:
-    escape_html(html, node->as.literal.data, node->as.literal.len);
+    escape_literal(renderer, &node->as.literal);
     break;
 
   case CMARK_NODE_LINEBREAK:
@@ -328,28 +584,24 @@ static int S_render_node(cmark_html_renderer *renderer, cmark_node *node,
 
   case CMARK_NODE_CODE:
     cmark_strbuf_puts(html, "<code>");
-    escape_html(html, node->as.literal.data, node->as.literal.len);
+    escape_literal(renderer, &node->as.literal);
     cmark_strbuf_puts(html, "</code>");
     break;
 
   case CMARK_NODE_HTML_INLINE:
     if (!(options & CMARK_OPT_UNSAFE)) {
       cmark_strbuf_puts(html, "<!-- raw HTML omitted -->");
+    } else if (S_fit_literal(renderer, node->as.literal.data,
+                             node->as.literal.len, false) <
+               node->as.literal.len) {
+      // As for HTML blocks.
+    } else if (S_has_html_filters(renderer) &&
+               S_html_filtered(renderer, node->as.literal.data,
+                               node->as.literal.len)) {
+      cmark_strbuf_puts(html, "&lt;");
+      cmark_strbuf_put(html, node->as.literal.data + 1, node->as.literal.len - 1);
     } else {
-      filtered = false;
-      for (it = renderer->filter_extensions; it; it = it->next) {
-        ext = (cmark_syntax_extension *) it->data;
-        if (!ext->html_filter_func(ext, node->as.literal.data, node->as.literal.len)) {
-          filtered = true;
-          break;
-        }
-      }
-      if (!filtered) {
-        cmark_strbuf_put(html, node->as.literal.data, node->as.literal.len);
-      } else {
-        cmark_strbuf_puts(html, "&lt;");
-        cmark_strbuf_put(html, node->as.literal.data + 1, node->as.literal.len - 1);
-      }
+      S_put_verbatim(renderer, node->as.literal.data, node->as.literal.len);
     }
     break;
 
@@ -469,34 +721,223 @@ char *cmark_render_html(cmark_node *root, int options, cmark_llist *extensions)
   return cmark_render_html_with_mem(root, options, extensions, cmark_node_mem(root));
 }
 
-char *cmark_render_html_with_mem(cmark_node *root, int options, cmark_llist *extensions, cmark_mem *mem) {
-  char *result;
-  cmark_strbuf html = CMARK_BUF_INIT(mem);
+// Passes all but the last byte of 'html' to 'write'.  The last byte stays
+// behind for cmark_html_render_cr, which looks at it to decide whether a
+// newline is needed.
+static bool S_flush_html(cmark_strbuf *html, cmark_write_func write,
+                         void *user_data) {
+  bufsize_t len = html->size - 1;
+
+  if (len <= 0)
+    return true;
+  if (write((const char *)html->ptr, (size_t)len, user_data) != 0)
+    return false;
+  html->ptr[0] = html->ptr[len];
+  cmark_strbuf_truncate(html, 1);
+  return true;
+}
+
+// Renders 'root' into 'html', which must be empty.  If 'write' is not
+// NULL, the output is passed to it whenever CMARK_WRITER_CHUNK bytes have
+// built up, and 'html' holds the unwritten rest on return.  If 'segments'
+// is not NULL, 'html' must be its buffer.  Returns false if 'write' failed.
+static bool S_render_html(cmark_strbuf *html, cmark_node *root, int options,
+                          cmark_llist *extensions, size_t max_len,
+                          int *truncated, cmark_write_func write,
+                          void *user_data, cmark_html_segments *segments) {
+  cmark_mem *mem = html->mem;
   cmark_event_type ev_type;
   cmark_node *cur;
-  cmark_html_renderer renderer = {&html, NULL, NULL, 0, 0, NULL};
-  cmark_iter *iter = cmark_iter_new(root);
-
-  for (; extensions; extensions = extensions->next)
-    if (((cmark_syntax_extension *) extensions->data)->html_filter_func)
+  cmark_html_renderer renderer = {html, NULL, NULL,     0,       0,    NULL,
+                                  NULL, NULL, segments, max_len, false};
+  cmark_iter_storage storage;
+  cmark_iter *iter = cmark_iter_init(&storage, root);
+  bool ok = true;
+
+  for (; extensions; extensions = extensions->next) {
+    cmark_syntax_extension *ext = (cmark_syntax_extension *) extensions->data;
+    if (ext->html_filter_tags)
+      renderer.filter_tag_extensions = cmark_llist_append(
+          mem, renderer.filter_tag_extensions, ext);
+    else if (ext->html_filter_func)
       renderer.filter_extensions = cmark_llist_append(
-          mem,
-          renderer.filter_extensions,
-          (cmark_syntax_extension *) extensions->data);
+          mem, renderer.filter_extensions, ext);
+  }
 
-  while ((ev_type = cmark_iter_next(iter)) != CMARK_EVENT_DONE) {
-    cur = cmark_iter_get_node(iter);
-    S_render_node(&renderer, cur, ev_type, options);
+  while ((ev_type = cmark_iter_step(iter)) != CMARK_EVENT_DONE) {
+    cur = iter->cur.node;
+    if (max_len && ev_type == CMARK_EVENT_ENTER &&
+        (size_t)html->size >= max_len && cur != root)
+      renderer.stopped = true;
+    else
+      S_render_node(&renderer, cur, ev_type, options);
+    if (renderer.stopped) {
+      // Out of budget, before 'cur' or within its literal: close every
+      // element that is still open, innermost first, and skip the rest of
+      // the tree.
+      while ((cur = cur->parent) != NULL) {
+        S_render_node(&renderer, cur, CMARK_EVENT_EXIT, options);
+        if (cur == root)
+          break;
+      }
+      break;
+    }
+    if (write && html->size >= CMARK_WRITER_CHUNK &&
+        !(ok = S_flush_html(html, write, user_data)))
+      break;
   }
 
-  if (renderer.footnote_ix) {
-    cmark_strbuf_puts(&html, "</ol>\n</section>\n");
+  if (ok && renderer.footnote_ix) {
+    cmark_strbuf_puts(html, "</ol>\n</section>\n");
   }
 
-  result = (char *)cmark_strbuf_detach(&html);
+  if (truncated)
+    *truncated = renderer.stopped || cmark_node_get_truncated(root);
 
   cmark_llist_free(mem, renderer.filter_extensions);
+  cmark_llist_free(mem, renderer.filter_tag_extensions);
+  S_tag_matcher_free(mem, renderer.tag_matcher);
+
+  return ok;
+}
+
+char *cmark_render_html_with_mem(cmark_node *root, int options, cmark_llist *extensions, cmark_mem *mem) {
+  cmark_strbuf html = CMARK_BUF_INIT(mem);
+
+  S_render_html(&html, root, options, extensions, 0, NULL, NULL, NULL, NULL);
+  return (char *)cmark_strbuf_detach(&html);
+}
+
+char *cmark_render_html_excerpt(cmark_node *root, int options,
+                                cmark_llist *extensions, size_t max_len,
+                                int *truncated) {
+  cmark_strbuf html = CMARK_BUF_INIT(cmark_node_mem(root));
+
+  S_render_html(&html, root, options, extensions, max_len, truncated, NULL,
+                NULL, NULL);
+  return (char *)cmark_strbuf_detach(&html);
+}
+
+int cmark_render_html_to_writer(cmark_node *root, int options,
+                                cmark_llist *extensions, cmark_write_func write,
+                                void *user_data) {
+  cmark_strbuf html = CMARK_BUF_INIT(cmark_node_mem(root));
+  bool ok;
+
+  cmark_strbuf_grow(&html, CMARK_WRITER_CHUNK);
+  ok = S_render_html(&html, root, options, extensions, 0, NULL, write,
+                     user_data, NULL) &&
+       (html.size == 0 ||
+        write((const char *)html.ptr, (size_t)html.size, user_data) == 0);
+  cmark_strbuf_free(&html);
+  return ok;
+}
+
+cmark_html_buffer *cmark_html_buffer_new_with_mem(cmark_mem *mem) {
+  cmark_html_buffer *buffer =
+      (cmark_html_buffer *)mem->calloc(1, sizeof(cmark_html_buffer));
+
+  cmark_strbuf_init(mem, &buffer->html, 0);
+  return buffer;
+}
+
+cmark_html_buffer *cmark_html_buffer_new(void) {
+  return cmark_html_buffer_new_with_mem(cmark_get_default_mem_allocator());
+}
+
+void cmark_render_html_to_buffer(cmark_html_buffer *buffer, cmark_node *root,
+                                 int options, cmark_llist *extensions) {
+  cmark_strbuf_clear(&buffer->html);
+  S_render_html(&buffer->html, root, options, extensions, 0, NULL, NULL, NULL,
+                NULL);
+}
+
+const char *cmark_html_buffer_data(const cmark_html_buffer *buffer) {
+  return (const char *)buffer->html.ptr;
+}
+
+size_t cmark_html_buffer_len(const cmark_html_buffer *buffer) {
+  return (size_t)buffer->html.size;
+}
+
+void cmark_html_buffer_reset(cmark_html_buffer *buffer) {
+  cmark_strbuf_clear(&buffer->html);
+}
+
+void cmark_html_buffer_free(cmark_html_buffer *buffer) {
+  cmark_mem *mem;
+
+  if (buffer == NULL)
+    return;
+  mem = buffer->html.mem;
+  cmark_strbuf_free(&buffer->html);
+  mem->free(buffer);
+}
+
+cmark_html_segments *cmark_render_html_segments(cmark_node *root, int options,
+                                                cmark_llist *extensions) {
+  cmark_mem *mem = cmark_node_mem(root);
+  cmark_html_segments *segments =
+      (cmark_html_segments *)mem->calloc(1, sizeof(cmark_html_segments));
+  const unsigned char *generated;
+  cmark_html_segment *item;
+  bufsize_t i, at = 0;
+
+  segments->mem = mem;
+  cmark_strbuf_init(mem, &segments->html, 0);
+  S_render_html(&segments->html, root, options, extensions, 0, NULL, NULL,
+                NULL, segments);
+
+  // Every reference is followed by at least one generated byte, so the
+  // generated pieces and references alternate.
+  generated = segments->html.ptr;
+  item = segments->items = (cmark_html_segment *)mem->calloc(
+      2 * (size_t)segments->nrefs + 1, sizeof(cmark_html_segment));
+  for (i = 0; i < segments->nrefs; i++) {
+    html_ref *ref = &segments->refs[i];
+    if (ref->at > at) {
+      item->data = (const char *)generated + at;
+      item->len = (size_t)(ref->at - at);
+      item++;
+      at = ref->at;
+    }
+    item->data = (const char *)ref->data;
+    item->len = (size_t)ref->len;
+    segments->length += item->len;
+    item++;
+  }
+  if (segments->html.size > at) {
+    item->data = (const char *)generated + at;
+    item->len = (size_t)(segments->html.size - at);
+    item++;
+  }
+  segments->count = (size_t)(item - segments->items);
+  segments->length += (size_t)segments->html.size;
+
+  mem->free(segments->refs);
+  segments->refs = NULL;
+  segments->nrefs = segments->refs_size = 0;
+
+  return segments;
+}
+
+const cmark_html_segment *
+cmark_html_segments_get(const cmark_html_segments *segments, size_t *count) {
+  *count = segments->count;
+  return segments->items;
+}
+
+size_t cmark_html_segments_length(const cmark_html_segments *segments) {
+  return segments->length;
+}
+
+void cmark_html_segments_free(cmark_html_segments *segments) {
+  cmark_mem *mem;
 
-  cmark_iter_free(iter);
-  return result;
+  if (segments == NULL)
+    return;
+  mem = segments->mem;
+  cmark_strbuf_free(&segments->html);
+  mem->free(segments->items);
+  mem->free(segments);
 }
@@ -42,6 +42,8 @@ typedef struct bracket {
   bool bracket_after;
   bool in_bracket_image0;
   bool in_bracket_image1;
+  // Number of footnote references recorded when this bracket was pushed
+  bufsize_t footnote_refs;
 } bracket;
 
 #define FLAG_SKIP_HTML_CDATA        (1u << 0)
@@ -60,14 +62,34 @@ typedef struct subject{
   cmark_map *refmap;
   delimiter *last_delim;
   bracket *last_bracket;
+  // Where released delimiters and brackets go; NULL to free them
+  cmark_inline_pool *pool;
   bufsize_t backticks[MAXBACKTICKS + 1];
   bool scanned_for_backticks;
   bool no_link_openers;
+  // Set when adjacent text nodes were left unmerged
+  bool unmerged_text;
 } subject;
 
 // Extensions may populate this.
 static int8_t SKIP_CHARS[256];
 
+// Bits of SPECIAL_CHARS: whether a byte may start inline syntax, and
+// which chunk flags a literal containing it cannot have.
+#define INLINE_SPECIAL 1
+#define HTML_SPECIAL 2
+#define NON_ASCII 4
+
+static int8_t SPECIAL_CHARS[256];
+
+// The chunk flags of a literal made of bytes whose SPECIAL_CHARS entries
+// OR to 'seen'.
+static CMARK_INLINE uint8_t literal_flags(int seen) {
+  return (uint8_t)(((seen & HTML_SPECIAL) ? 0 : CMARK_CHUNK_NO_HTML_SPECIAL) |
+                   ((seen & NON_ASCII) ? 0 : CMARK_CHUNK_ASCII));
+}
+
+
 static CMARK_INLINE bool S_is_line_end_char(char c) {
   return (c == '\n' || c == '\r');
 }
@@ -78,7 +100,8 @@ static delimiter *S_insert_emph(subject *subj, delimiter *opener,
 static int parse_inline(cmark_parser *parser, subject *subj, cmark_node *parent, int options);
 
 static void subject_from_buf(cmark_mem *mem, int line_number, int block_offset, subject *e,
-                             cmark_chunk *buffer, cmark_map *refmap);
+                             cmark_chunk *buffer, cmark_map *refmap,
+                             cmark_inline_pool *pool);
 static bufsize_t subject_find_special_char(subject *subj, int options);
 
 // Create an inline with a literal string value.
@@ -117,6 +140,34 @@ static cmark_node *make_str_with_entities(subject *subj,
   }
 }
 
+// Whether node is the text of the innermost delimiter or bracket.  Only
+// the last appended node can be, and both stacks grow in document order.
+static CMARK_INLINE bool is_stacked(subject *subj, cmark_node *node) {
+  return (subj->last_delim && subj->last_delim->inl_text == node) ||
+         (subj->last_bracket && subj->last_bracket->inl_text == node);
+}
+
+// Extend text's literal by lit without copying.  This is possible when
+// text is a view into the subject and the input continues with exactly the
+// bytes of lit, whatever buffer those live in.
+static bool extend_text(subject *subj, cmark_node *text, const cmark_chunk *lit,
+                        int end_column) {
+  cmark_chunk *text_lit = &text->as.literal;
+  const unsigned char *input_end = subj->input.data + subj->input.len;
+  const unsigned char *end = text_lit->data + text_lit->len;
+
+  if (text_lit->alloc || text_lit->data < subj->input.data ||
+      end > input_end || lit->len > input_end - end)
+    return false;
+  if (lit->len && lit->data != end && memcmp(end, lit->data, lit->len) != 0)
+    return false;
+
+  text_lit->len += lit->len;
+  text_lit->flags &= lit->flags;
+  text->end_column = end_column;
+  return true;
+}
+
 // Like cmark_node_append_child but without costly sanity checks.
 // Assumes that child was newly created.
 static void append_child(cmark_node *node, cmark_node *child) {
@@ -144,6 +195,7 @@ static cmark_chunk chunk_clone(cmark_mem *mem, cmark_chunk *src) {
   c.len = len;
   c.data = (unsigned char *)mem->calloc(len + 1, 1);
   c.alloc = 1;
+  c.flags = src->flags;
   if (len)
     memcpy(c.data, src->data, len);
   c.data[len] = '\0';
@@ -183,7 +235,8 @@ static CMARK_INLINE cmark_node *make_autolink(subject *subj,
 }
 
 static void subject_from_buf(cmark_mem *mem, int line_number, int block_offset, subject *e,
-                             cmark_chunk *chunk, cmark_map *refmap) {
+                             cmark_chunk *chunk, cmark_map *refmap,
+                             cmark_inline_pool *pool) {
   int i;
   e->mem = mem;
   e->input = *chunk;
@@ -195,11 +248,13 @@ static void subject_from_buf(cmark_mem *mem, int line_number, int block_offset,
   e->refmap = refmap;
   e->last_delim = NULL;
   e->last_bracket = NULL;
+  e->pool = pool;
   for (i = 0; i <= MAXBACKTICKS; i++) {
     e->backticks[i] = 0;
   }
   e->scanned_for_backticks = false;
   e->no_link_openers = true;
+  e->unmerged_text = false;
 }
 
 static CMARK_INLINE int isbacktick(int c) { return (c == '`'); }
@@ -352,11 +407,14 @@ static bufsize_t scan_to_closing_backticks(subject *subj,
 // Destructively modify string, converting newlines to
 // spaces, then removing a single leading + trailing space,
 // unless the code span consists entirely of space characters.
-static void S_normalize_code(cmark_strbuf *s) {
+// Returns the chunk flags of the normalized code.
+static uint8_t S_normalize_code(cmark_strbuf *s) {
   bufsize_t r, w;
   bool contains_nonspace = false;
+  int seen = 0;
 
   for (r = 0, w = 0; r < s->size; ++r) {
+    seen |= SPECIAL_CHARS[s->ptr[r]];
     switch (s->ptr[r]) {
     case '\r':
       if (s->ptr[r + 1] != '\n') {
@@ -383,6 +441,7 @@ static void S_normalize_code(cmark_strbuf *s) {
     cmark_strbuf_truncate(s, w);
   }
 
+  return literal_flags(seen);
 }
 
 
@@ -398,12 +457,14 @@ static cmark_node *handle_backticks(subject *subj, int options) {
     return make_str(subj, subj->pos, subj->pos, openticks);
   } else {
     cmark_strbuf buf = CMARK_BUF_INIT(subj->mem);
+    uint8_t flags;
 
     cmark_strbuf_set(&buf, subj->input.data + startpos,
                      endpos - startpos - openticks.len);
-    S_normalize_code(&buf);
+    flags = S_normalize_code(&buf);
 
     cmark_node *node = make_code(subj, startpos, endpos - openticks.len - 1, cmark_chunk_buf_detach(&buf));
+    node->as.literal.flags = flags;
     adjust_subj_node_newlines(subj, node, endpos - startpos, openticks.len, options);
     return node;
   }
@@ -512,7 +573,12 @@ static void remove_delimiter(subject *subj, delimiter *delim) {
   if (delim->previous != NULL) {
     delim->previous->next = delim->next;
   }
-  subj->mem->free(delim);
+  if (subj->pool) {
+    delim->previous = subj->pool->delimiters;
+    subj->pool->delimiters = delim;
+  } else {
+    subj->mem->free(delim);
+  }
 }
 
 static void pop_bracket(subject *subj) {
@@ -521,12 +587,36 @@ static void pop_bracket(subject *subj) {
     return;
   b = subj->last_bracket;
   subj->last_bracket = subj->last_bracket->previous;
-  subj->mem->free(b);
+  if (subj->pool) {
+    b->previous = subj->pool->brackets;
+    subj->pool->brackets = b;
+  } else {
+    subj->mem->free(b);
+  }
+}
+
+void cmark_inline_pool_free(cmark_mem *mem, cmark_inline_pool *pool) {
+  while (pool->delimiters) {
+    delimiter *delim = pool->delimiters;
+    pool->delimiters = delim->previous;
+    mem->free(delim);
+  }
+  while (pool->brackets) {
+    bracket *b = pool->brackets;
+    pool->brackets = b->previous;
+    mem->free(b);
+  }
 }
 
 static void push_delimiter(subject *subj, unsigned char c, bool can_open,
                            bool can_close, cmark_node *inl_text) {
-  delimiter *delim = (delimiter *)subj->mem->calloc(1, sizeof(delimiter));
+  delimiter *delim;
+  if (subj->pool && subj->pool->delimiters) {
+    delim = subj->pool->delimiters;
+    subj->pool->delimiters = delim->previous;
+  } else {
+    delim = (delimiter *)subj->mem->calloc(1, sizeof(delimiter));
+  }
   delim->delim_char = c;
   delim->can_open = can_open;
   delim->can_close = can_close;
@@ -541,8 +631,17 @@ static void push_delimiter(subject *subj, unsigned char c, bool can_open,
   subj->last_delim = delim;
 }
 
-static void push_bracket(subject *subj, bool image, cmark_node *inl_text) {
-  bracket *b = (bracket *)subj->mem->calloc(1, sizeof(bracket));
+static void push_bracket(cmark_parser *parser, subject *subj, bool image,
+                         cmark_node *inl_text) {
+  bracket *b;
+  if (subj->pool && subj->pool->brackets) {
+    b = subj->pool->brackets;
+    subj->pool->brackets = b->previous;
+  } else {
+    b = (bracket *)subj->mem->calloc(1, sizeof(bracket));
+  }
+  b->in_bracket_image0 = false;
+  b->in_bracket_image1 = false;
   if (subj->last_bracket != NULL) {
     subj->last_bracket->bracket_after = true;
     b->in_bracket_image0 = subj->last_bracket->in_bracket_image0;
@@ -554,6 +653,7 @@ static void push_bracket(subject *subj, bool image, cmark_node *inl_text) {
   b->previous = subj->last_bracket;
   b->position = subj->pos;
   b->bracket_after = false;
+  b->footnote_refs = parser->footnote_refs.size;
   if (image) {
     b->in_bracket_image1 = true;
   } else {
@@ -652,21 +752,10 @@ static cmark_node *handle_period(subject *subj, bool smart) {
 }
 
 static cmark_syntax_extension *get_extension_for_special_char(cmark_parser *parser, unsigned char c) {
-  cmark_llist *tmp_ext;
-
-  for (tmp_ext = parser->inline_syntax_extensions; tmp_ext; tmp_ext=tmp_ext->next) {
-    cmark_syntax_extension *ext = (cmark_syntax_extension *) tmp_ext->data;
-    cmark_llist *tmp_char;
-    for (tmp_char = ext->special_inline_chars; tmp_char; tmp_char=tmp_char->next) {
-      unsigned char tmp_c = (unsigned char)(size_t)tmp_char->data;
-
-      if (tmp_c == c) {
-        return ext;
-      }
-    }
-  }
+  if (!parser->inline_dispatch)
+    return NULL;
 
-  return NULL;
+  return parser->inline_dispatch->owner[c];
 }
 
 static void process_emphasis(cmark_parser *parser, subject *subj, bufsize_t stack_bottom) {
@@ -1095,7 +1184,7 @@ static bufsize_t manual_scan_link_url_2(cmark_chunk *input, bufsize_t offset,
     return -1;
 
   {
-    cmark_chunk result = {input->data + offset, i - offset, 0};
+    cmark_chunk result = {input->data + offset, i - offset, 0, 0};
     *output = result;
   }
   return i - offset;
@@ -1126,7 +1215,7 @@ static bufsize_t manual_scan_link_url(cmark_chunk *input, bufsize_t offset,
     return -1;
 
   {
-    cmark_chunk result = {input->data + offset + 1, i - 2 - offset, 0};
+    cmark_chunk result = {input->data + offset + 1, i - 2 - offset, 0, 0};
     *output = result;
   }
   return i - offset;
@@ -1285,6 +1374,11 @@ noMatch:
       // being replacing the opening '[' text node with a `^footnote-ref]` node.
       cmark_node_insert_before(opener->inl_text, fnref);
 
+      // Every reference recorded since the opener was pushed lies after it
+      // and is freed below.
+      parser->footnote_refs.size = opener->footnote_refs;
+      cmark_node_list_append(parser->mem, &parser->footnote_refs, fnref);
+
       process_emphasis(parser, subj, opener->position);
       // sometimes, the footnote reference text gets parsed into multiple nodes
       // i.e. '[^example]' parsed into '[', '^exam', 'ple]'.
@@ -1374,19 +1468,19 @@ static cmark_node *handle_newline(subject *subj) {
   }
 }
 
-// "\r\n\\`&_*[]<!"
+// INLINE_SPECIAL: "\r\n\\`&_*[]<!"; HTML_SPECIAL: &<>"; NON_ASCII: 0x80-0xFF
 static int8_t SPECIAL_CHARS[256] = {
       0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
       0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 1,
       1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+      0, 0, 0, 0, 0, 0, 0, 0, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+      4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+      4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+      4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+      4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+      4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4};
 
 // " ' . -
 static char SMART_PUNCT_CHARS[] = {
@@ -1403,11 +1497,34 @@ static char SMART_PUNCT_CHARS[] = {
       0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 };
 
+// The bytes that rule out a chunk flag: HTML_SPECIAL or NON_ASCII set in
+// SPECIAL_CHARS.
+static const houdini_byte_class LITERAL_FLAG_CLASS = {
+    {0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x08, 0x00, 0x08, 0x00},
+    0x80, (const char *)SPECIAL_CHARS, HTML_SPECIAL, 8 - HTML_SPECIAL};
+
+// The chunk flags of data[start..end).  Text is mostly clean, so this
+// skips ahead to the first byte that is not and only looks at the rest
+// byte by byte.
+static uint8_t chunk_flags(const unsigned char *data, bufsize_t start,
+                           bufsize_t end) {
+  bufsize_t i = houdini_scan(&LITERAL_FLAG_CLASS, data, start, end);
+  int seen = 0;
+
+  for (; i < end && (seen & (HTML_SPECIAL | NON_ASCII)) !=
+                        (HTML_SPECIAL | NON_ASCII);
+       ++i)
+    seen |= SPECIAL_CHARS[data[i]];
+
+  return literal_flags(seen);
+}
+
 static bufsize_t subject_find_special_char(subject *subj, int options) {
   bufsize_t n = subj->pos + 1;
 
   while (n < subj->input.len) {
-    if (SPECIAL_CHARS[subj->input.data[n]])
+    if (SPECIAL_CHARS[subj->input.data[n]] & INLINE_SPECIAL)
       return n;
     if (options & CMARK_OPT_SMART && SMART_PUNCT_CHARS[subj->input.data[n]])
       return n;
@@ -1418,13 +1535,13 @@ static bufsize_t subject_find_special_char(subject *subj, int options) {
 }
 
 void cmark_inlines_add_special_character(unsigned char c, bool emphasis) {
-  SPECIAL_CHARS[c] = 1;
+  SPECIAL_CHARS[c] |= INLINE_SPECIAL;
   if (emphasis)
     SKIP_CHARS[c] = 1;
 }
 
 void cmark_inlines_remove_special_character(unsigned char c, bool emphasis) {
-  SPECIAL_CHARS[c] = 0;
+  SPECIAL_CHARS[c] &= ~INLINE_SPECIAL;
   if (emphasis)
     SKIP_CHARS[c] = 0;
 }
@@ -1433,11 +1550,15 @@ static cmark_node *try_extensions(cmark_parser *parser,
                                   cmark_node *parent,
                                   unsigned char c,
                                   subject *subj) {
+  cmark_inline_dispatch *dispatch = parser->inline_dispatch;
   cmark_node *res = NULL;
-  cmark_llist *tmp;
+  uint16_t i;
+
+  if (!dispatch)
+    return NULL;
 
-  for (tmp = parser->inline_syntax_extensions; tmp; tmp = tmp->next) {
-    cmark_syntax_extension *ext = (cmark_syntax_extension *) tmp->data;
+  for (i = dispatch->start[c]; i < dispatch->start[c + 1]; ++i) {
+    cmark_syntax_extension *ext = dispatch->exts[i];
     res = ext->match_inline(ext, parser, parent, c, subj);
 
     if (res)
@@ -1490,7 +1611,7 @@ static int parse_inline(cmark_parser *parser, subject *subj, cmark_node *parent,
   case '[':
     advance(subj);
     new_inl = make_str(subj, subj->pos - 1, subj->pos - 1, cmark_chunk_literal("["));
-    push_bracket(subj, false, new_inl);
+    push_bracket(parser, subj, false, new_inl);
     break;
   case ']':
     new_inl = handle_close_bracket(parser, subj);
@@ -1500,7 +1621,7 @@ static int parse_inline(cmark_parser *parser, subject *subj, cmark_node *parent,
     if (peek_char(subj) == '[' && peek_char_n(subj, 1) != '^') {
       advance(subj);
       new_inl = make_str(subj, subj->pos - 2, subj->pos - 1, cmark_chunk_literal("!["));
-      push_bracket(subj, true, new_inl);
+      push_bracket(parser, subj, true, new_inl);
     } else {
       new_inl = make_str(subj, subj->pos - 1, subj->pos - 1, cmark_chunk_literal("!"));
     }
@@ -1512,6 +1633,7 @@ static int parse_inline(cmark_parser *parser, subject *subj, cmark_node *parent,
 
     endpos = subject_find_special_char(subj, options);
     contents = cmark_chunk_dup(&subj->input, subj->pos, endpos - subj->pos);
+    contents.flags = chunk_flags(subj->input.data, subj->pos, endpos);
     startpos = subj->pos;
     subj->pos = endpos;
 
@@ -1520,23 +1642,88 @@ static int parse_inline(cmark_parser *parser, subject *subj, cmark_node *parent,
       cmark_chunk_rtrim(&contents);
     }
 
+    // Continue the previous text node rather than creating one to merge.
+    if (parent->last_child &&
+        parent->last_child->type == CMARK_NODE_TEXT &&
+        !is_stacked(subj, parent->last_child) &&
+        extend_text(subj, parent->last_child, &contents,
+                    endpos + subj->column_offset + subj->block_offset))
+      return 1;
+
     new_inl = make_str(subj, startpos, endpos - 1, contents);
   }
   if (new_inl != NULL) {
+    cmark_node *last = parent->last_child;
+
+    if (new_inl->type == CMARK_NODE_TEXT && last &&
+        last->type == CMARK_NODE_TEXT) {
+      // Delimiter and bracket nodes may still be rewritten or moved, so
+      // only merge text that is no longer referenced from either stack.
+      if (!is_stacked(subj, new_inl) && !is_stacked(subj, last) &&
+          extend_text(subj, last, &new_inl->as.literal, new_inl->end_column)) {
+        cmark_node_free(new_inl);
+        return 1;
+      }
+      subj->unmerged_text = true;
+    }
     append_child(parent, new_inl);
   }
 
   return 1;
 }
 
+// Merge each run of adjacent text nodes below root into its first node,
+// leaving the same tree cmark_consolidate_text_nodes would.
+static void merge_text_runs(subject *subj, cmark_node *root) {
+  cmark_strbuf buf = CMARK_BUF_INIT(subj->mem);
+  cmark_node *cur = root->first_child;
+  cmark_node *next;
+
+  while (cur) {
+    if (cur->type == CMARK_NODE_TEXT) {
+      while ((next = cur->next) && next->type == CMARK_NODE_TEXT) {
+        if (!extend_text(subj, cur, &next->as.literal, next->end_column)) {
+          // Fall back to copying the rest of the run.
+          uint8_t flags = cur->as.literal.flags;
+
+          cmark_strbuf_put(&buf, cur->as.literal.data, cur->as.literal.len);
+          do {
+            cmark_strbuf_put(&buf, next->as.literal.data, next->as.literal.len);
+            flags &= next->as.literal.flags;
+            cur->end_column = next->end_column;
+            cmark_node_free(next);
+          } while ((next = cur->next) && next->type == CMARK_NODE_TEXT);
+          cmark_chunk_free(subj->mem, &cur->as.literal);
+          cur->as.literal = cmark_chunk_buf_detach(&buf);
+          cur->as.literal.flags = flags;
+          break;
+        }
+        cmark_node_free(next);
+      }
+    }
+
+    if (cur->first_child) {
+      cur = cur->first_child;
+    } else {
+      while (cur != root && cur->next == NULL)
+        cur = cur->parent;
+      cur = cur == root ? NULL : cur->next;
+    }
+  }
+
+  cmark_strbuf_free(&buf);
+}
+
 // Parse inlines from parent's string_content, adding as children of parent.
 void cmark_parse_inlines(cmark_parser *parser,
                          cmark_node *parent,
                          cmark_map *refmap,
                          int options) {
+  cmark_scratch_mark mark = cmark_scratch_get_mark(&parser->scratch);
   subject subj;
-  cmark_chunk content = {parent->content.ptr, parent->content.size, 0};
-  subject_from_buf(parser->mem, parent->start_line, parent->start_column - 1 + parent->internal_offset, &subj, &content, refmap);
+  cmark_llist *it;
+  cmark_chunk content = {parent->content.ptr, parent->content.size, 0, 0};
+  subject_from_buf(parser->mem, parent->start_line, parent->start_column - 1 + parent->internal_offset, &subj, &content, refmap, &parser->inline_pool);
   cmark_chunk_rtrim(&subj.input);
 
   while (!is_eof(&subj) && parse_inline(parser, &subj, parent, options))
@@ -1550,6 +1737,17 @@ void cmark_parse_inlines(cmark_parser *parser,
   while (subj.last_bracket) {
     pop_bracket(&subj);
   }
+
+  if (subj.unmerged_text)
+    merge_text_runs(&subj, parent);
+
+  for (it = parser->syntax_extensions; it; it = it->next) {
+    cmark_syntax_extension *ext = (cmark_syntax_extension *)it->data;
+    if (ext->postprocess_inlines_func)
+      ext->postprocess_inlines_func(ext, parser, parent);
+  }
+
+  cmark_scratch_release(&parser->scratch, mark);
 }
 
 // Parse zero or more space characters, including at most one newline.
@@ -1575,7 +1773,7 @@ bufsize_t cmark_parse_reference_inline(cmark_mem *mem, cmark_chunk *input,
   bufsize_t matchlen = 0;
   bufsize_t beforetitle;
 
-  subject_from_buf(mem, -1, 0, &subj, input, NULL);
+  subject_from_buf(mem, -1, 0, &subj, input, NULL, NULL);
 
   // parse label:
   if (!link_label(&subj, &lab) || lab.len == 0)
@@ -1638,34 +1836,95 @@ int cmark_inline_parser_is_eof(cmark_inline_parser *parser) {
   return is_eof(parser);
 }
 
-static char *
-my_strndup (const char *s, size_t n)
-{
-  char *result;
-  size_t len = strlen (s);
-
-  if (n < len)
-    len = n;
+char *cmark_inline_parser_take_while(cmark_inline_parser *parser, cmark_inline_predicate pred) {
+  cmark_inline_span span = cmark_inline_parser_take_while_span(parser, pred);
+  char *result = (char *)malloc(span.len + 1);
 
-  result = (char *) malloc (len + 1);
   if (!result)
-    return 0;
+    return NULL;
 
-  result[len] = '\0';
-  return (char *) memcpy (result, s, len);
+  memcpy(result, span.data, span.len);
+  result[span.len] = '\0';
+  return result;
 }
 
-char *cmark_inline_parser_take_while(cmark_inline_parser *parser, cmark_inline_predicate pred) {
-  unsigned char c;
+#define BYTE_SET_HAS(set, c) ((set)->bits[(c) >> 3] & (1 << ((c) & 7)))
+
+void cmark_inline_byte_set_init(cmark_inline_byte_set *set, const char *bytes) {
+  const unsigned char *c;
+
+  memset(set->bits, 0, sizeof(set->bits));
+  for (c = (const unsigned char *)bytes; *c; ++c)
+    set->bits[*c >> 3] |= (unsigned char)(1 << (*c & 7));
+}
+
+cmark_inline_span cmark_inline_parser_take_while_span(cmark_inline_parser *parser,
+                                                      cmark_inline_predicate pred) {
+  cmark_inline_span span;
   bufsize_t startpos = parser->pos;
-  bufsize_t len = 0;
+  unsigned char c;
 
-  while ((c = peek_char(parser)) && (*pred)(c)) {
+  while ((c = peek_char(parser)) && (*pred)(c))
     advance(parser);
-    len++;
-  }
 
-  return my_strndup((const char *) parser->input.data + startpos, len);
+  span.data = parser->input.data + startpos;
+  span.len = parser->pos - startpos;
+  return span;
+}
+
+cmark_inline_span cmark_inline_parser_take_while_in_set(cmark_inline_parser *parser,
+                                                        const cmark_inline_byte_set *set) {
+  cmark_inline_span span;
+  const unsigned char *data = parser->input.data;
+  bufsize_t startpos = parser->pos, pos = startpos;
+
+  while (pos < parser->input.len && BYTE_SET_HAS(set, data[pos]))
+    pos++;
+
+  parser->pos = pos;
+  span.data = data + startpos;
+  span.len = pos - startpos;
+  return span;
+}
+
+cmark_inline_span cmark_inline_parser_get_span(cmark_inline_parser *parser,
+                                               int offset, int len) {
+  cmark_inline_span span;
+
+  if (offset < 0)
+    offset = 0;
+  if (offset > parser->input.len)
+    offset = parser->input.len;
+  if (len < 0)
+    len = 0;
+  if (len > parser->input.len - offset)
+    len = parser->input.len - offset;
+
+  span.data = parser->input.data + offset;
+  span.len = len;
+  return span;
+}
+
+int cmark_inline_parser_find_byte(cmark_inline_parser *parser, unsigned char c) {
+  const unsigned char *found;
+
+  if (parser->pos >= parser->input.len)
+    return parser->input.len;
+
+  found = (const unsigned char *)memchr(parser->input.data + parser->pos, c,
+                                        parser->input.len - parser->pos);
+  return found ? (int)(found - parser->input.data) : parser->input.len;
+}
+
+int cmark_inline_parser_find_in_set(cmark_inline_parser *parser,
+                                    const cmark_inline_byte_set *set) {
+  const unsigned char *data = parser->input.data;
+  bufsize_t pos = parser->pos, len = parser->input.len;
+
+  while (pos < len && !BYTE_SET_HAS(set, data[pos]))
+    pos++;
+
+  return pos < len ? pos : len;
 }
 
 void cmark_inline_parser_push_delimiter(cmark_inline_parser *parser,
@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 #include "references.h"
+#include "parser.h"
 
 cmark_chunk cmark_clean_url(cmark_mem *mem, cmark_chunk *url);
 cmark_chunk cmark_clean_title(cmark_mem *mem, cmark_chunk *title);
@@ -19,6 +20,8 @@ void cmark_parse_inlines(cmark_parser *parser,
 bufsize_t cmark_parse_reference_inline(cmark_mem *mem, cmark_chunk *input,
                                        cmark_map *refmap);
 
+void cmark_inline_pool_free(cmark_mem *mem, cmark_inline_pool *pool);
+
 void cmark_inlines_add_special_character(unsigned char c, bool emphasis);
 void cmark_inlines_remove_special_character(unsigned char c, bool emphasis);
 
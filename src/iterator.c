@@ -6,82 +6,50 @@
 #include "cmark-gfm.h"
 #include "iterator.h"
 
-cmark_iter *cmark_iter_new(cmark_node *root) {
-  if (root == NULL) {
-    return NULL;
-  }
-  cmark_mem *mem = root->content.mem;
-  cmark_iter *iter = (cmark_iter *)mem->calloc(1, sizeof(cmark_iter));
-  iter->mem = mem;
+// cmark_iter_storage must be able to hold a cmark_iter.
+typedef char cmark_iter_storage_is_large_enough
+    [sizeof(cmark_iter_storage) >= sizeof(cmark_iter) ? 1 : -1];
+
+static void S_iter_start(cmark_iter *iter, cmark_node *root) {
+  iter->mem = root->content.mem;
   iter->root = root;
   iter->cur.ev_type = CMARK_EVENT_NONE;
   iter->cur.node = NULL;
   iter->next.ev_type = CMARK_EVENT_ENTER;
   iter->next.node = root;
-  return iter;
 }
 
-void cmark_iter_free(cmark_iter *iter) { iter->mem->free(iter); }
-
-static bool S_is_leaf(cmark_node *node) {
-  switch (node->type) {
-  case CMARK_NODE_HTML_BLOCK:
-  case CMARK_NODE_THEMATIC_BREAK:
-  case CMARK_NODE_CODE_BLOCK:
-  case CMARK_NODE_TEXT:
-  case CMARK_NODE_SOFTBREAK:
-  case CMARK_NODE_LINEBREAK:
-  case CMARK_NODE_CODE:
-  case CMARK_NODE_HTML_INLINE:
-    return 1;
+cmark_iter *cmark_iter_new(cmark_node *root) {
+  if (root == NULL) {
+    return NULL;
   }
-  return 0;
+  cmark_mem *mem = root->content.mem;
+  cmark_iter *iter = (cmark_iter *)mem->calloc(1, sizeof(cmark_iter));
+  S_iter_start(iter, root);
+  return iter;
 }
 
-cmark_event_type cmark_iter_next(cmark_iter *iter) {
-  cmark_event_type ev_type = iter->next.ev_type;
-  cmark_node *node = iter->next.node;
-
-  iter->cur.ev_type = ev_type;
-  iter->cur.node = node;
+cmark_iter *cmark_iter_init(cmark_iter_storage *storage, cmark_node *root) {
+  cmark_iter *iter = (cmark_iter *)storage;
 
-  if (ev_type == CMARK_EVENT_DONE) {
-    return ev_type;
+  if (root == NULL) {
+    return NULL;
   }
+  S_iter_start(iter, root);
+  return iter;
+}
 
-  /* roll forward to next item, setting both fields */
-  if (ev_type == CMARK_EVENT_ENTER && !S_is_leaf(node)) {
-    if (node->first_child == NULL) {
-      /* stay on this node but exit */
-      iter->next.ev_type = CMARK_EVENT_EXIT;
-    } else {
-      iter->next.ev_type = CMARK_EVENT_ENTER;
-      iter->next.node = node->first_child;
-    }
-  } else if (node == iter->root) {
-    /* don't move past root */
-    iter->next.ev_type = CMARK_EVENT_DONE;
-    iter->next.node = NULL;
-  } else if (node->next) {
-    iter->next.ev_type = CMARK_EVENT_ENTER;
-    iter->next.node = node->next;
-  } else if (node->parent) {
-    iter->next.ev_type = CMARK_EVENT_EXIT;
-    iter->next.node = node->parent;
-  } else {
-    assert(false);
-    iter->next.ev_type = CMARK_EVENT_DONE;
-    iter->next.node = NULL;
-  }
+void cmark_iter_free(cmark_iter *iter) { iter->mem->free(iter); }
 
-  return ev_type;
+cmark_event_type cmark_iter_next(cmark_iter *iter) {
+  return cmark_iter_step(iter);
 }
 
 void cmark_iter_reset(cmark_iter *iter, cmark_node *current,
                       cmark_event_type event_type) {
   iter->next.ev_type = event_type;
   iter->next.node = current;
-  cmark_iter_next(iter);
+  cmark_iter_step(iter);
 }
 
 cmark_node *cmark_iter_get_node(cmark_iter *iter) { return iter->cur.node; }
@@ -96,20 +64,21 @@ void cmark_consolidate_text_nodes(cmark_node *root) {
   if (root == NULL) {
     return;
   }
-  cmark_iter *iter = cmark_iter_new(root);
+  cmark_iter_storage storage;
+  cmark_iter *iter = cmark_iter_init(&storage, root);
   cmark_strbuf buf = CMARK_BUF_INIT(iter->mem);
   cmark_event_type ev_type;
   cmark_node *cur, *tmp, *next;
 
-  while ((ev_type = cmark_iter_next(iter)) != CMARK_EVENT_DONE) {
-    cur = cmark_iter_get_node(iter);
+  while ((ev_type = cmark_iter_step(iter)) != CMARK_EVENT_DONE) {
+    cur = iter->cur.node;
     if (ev_type == CMARK_EVENT_ENTER && cur->type == CMARK_NODE_TEXT &&
         cur->next && cur->next->type == CMARK_NODE_TEXT) {
       cmark_strbuf_clear(&buf);
       cmark_strbuf_put(&buf, cur->as.literal.data, cur->as.literal.len);
       tmp = cur->next;
       while (tmp && tmp->type == CMARK_NODE_TEXT) {
-        cmark_iter_next(iter); // advance pointer
+        cmark_iter_step(iter); // advance pointer
         cmark_strbuf_put(&buf, tmp->as.literal.data, tmp->as.literal.len);
         cur->end_column = tmp->end_column;
         next = tmp->next;
@@ -122,19 +91,19 @@ void cmark_consolidate_text_nodes(cmark_node *root) {
   }
 
   cmark_strbuf_free(&buf);
-  cmark_iter_free(iter);
 }
 
 void cmark_node_own(cmark_node *root) {
   if (root == NULL) {
     return;
   }
-  cmark_iter *iter = cmark_iter_new(root);
+  cmark_iter_storage storage;
+  cmark_iter *iter = cmark_iter_init(&storage, root);
   cmark_event_type ev_type;
   cmark_node *cur;
 
-  while ((ev_type = cmark_iter_next(iter)) != CMARK_EVENT_DONE) {
-    cur = cmark_iter_get_node(iter);
+  while ((ev_type = cmark_iter_step(iter)) != CMARK_EVENT_DONE) {
+    cur = iter->cur.node;
     if (ev_type == CMARK_EVENT_ENTER) {
       switch (cur->type) {
       case CMARK_NODE_TEXT:
@@ -154,6 +123,4 @@ void cmark_node_own(cmark_node *root) {
       }
     }
   }
-
-  cmark_iter_free(iter);
 }
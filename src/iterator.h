@@ -5,7 +5,11 @@
 extern "C" {
 #endif
 
+#include <assert.h>
+
 #include "cmark-gfm.h"
+#include "config.h"
+#include "node.h"
 
 typedef struct {
   cmark_event_type ev_type;
@@ -19,6 +23,68 @@ struct cmark_iter {
   cmark_iter_state next;
 };
 
+/* The node types that only get an ENTER event, as bits of their value. */
+#define CMARK_ITER_BIT(type) (1u << ((type) & CMARK_NODE_VALUE_MASK))
+#define CMARK_ITER_BLOCK_LEAVES                                                \
+  (CMARK_ITER_BIT(CMARK_NODE_CODE_BLOCK) |                                     \
+   CMARK_ITER_BIT(CMARK_NODE_HTML_BLOCK) |                                     \
+   CMARK_ITER_BIT(CMARK_NODE_THEMATIC_BREAK))
+#define CMARK_ITER_INLINE_LEAVES                                               \
+  (CMARK_ITER_BIT(CMARK_NODE_TEXT) | CMARK_ITER_BIT(CMARK_NODE_SOFTBREAK) |    \
+   CMARK_ITER_BIT(CMARK_NODE_LINEBREAK) | CMARK_ITER_BIT(CMARK_NODE_CODE) |    \
+   CMARK_ITER_BIT(CMARK_NODE_HTML_INLINE))
+
+static CMARK_INLINE bool cmark_iter_is_leaf(cmark_node *node) {
+  unsigned value = node->type & CMARK_NODE_VALUE_MASK;
+  unsigned leaves = (node->type & CMARK_NODE_TYPE_MASK) == CMARK_NODE_TYPE_INLINE
+                        ? CMARK_ITER_INLINE_LEAVES
+                        : CMARK_ITER_BLOCK_LEAVES;
+
+  return value < 32 && ((leaves >> value) & 1);
+}
+
+/* Internal passes iterate with a cmark_iter on the stack (see
+ * cmark_iter_init) and step it with this inline version of
+ * cmark_iter_next. */
+static CMARK_INLINE cmark_event_type cmark_iter_step(cmark_iter *iter) {
+  cmark_event_type ev_type = iter->next.ev_type;
+  cmark_node *node = iter->next.node;
+
+  iter->cur.ev_type = ev_type;
+  iter->cur.node = node;
+
+  if (ev_type == CMARK_EVENT_DONE) {
+    return ev_type;
+  }
+
+  /* roll forward to next item, setting both fields */
+  if (ev_type == CMARK_EVENT_ENTER && !cmark_iter_is_leaf(node)) {
+    if (node->first_child == NULL) {
+      /* stay on this node but exit */
+      iter->next.ev_type = CMARK_EVENT_EXIT;
+    } else {
+      iter->next.ev_type = CMARK_EVENT_ENTER;
+      iter->next.node = node->first_child;
+    }
+  } else if (node == iter->root) {
+    /* don't move past root */
+    iter->next.ev_type = CMARK_EVENT_DONE;
+    iter->next.node = NULL;
+  } else if (node->next) {
+    iter->next.ev_type = CMARK_EVENT_ENTER;
+    iter->next.node = node->next;
+  } else if (node->parent) {
+    iter->next.ev_type = CMARK_EVENT_EXIT;
+    iter->next.node = node->parent;
+  } else {
+    assert(false);
+    iter->next.ev_type = CMARK_EVENT_DONE;
+    iter->next.node = NULL;
+  }
+
+  return ev_type;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -13,6 +13,9 @@
 #include "syntax_extension.h"
 
 #define OUT(s, wrap, escaping) renderer->out(renderer, node, s, wrap, escaping)
+#define OUT_CHUNK(c, wrap, escaping)                                           \
+  renderer->out_len(renderer, node, (const char *)(c)->data, (c)->len, wrap,   \
+                    escaping)
 #define LIT(s) renderer->out(renderer, node, s, false, LITERAL)
 #define CR() renderer->cr(renderer)
 #define BLANKLINE() renderer->blankline(renderer)
@@ -219,6 +222,21 @@ static int S_get_enumlevel(cmark_node *node) {
   return enumlevel;
 }
 
+// The bytes outc writes out unchanged, for cmark_render: printable ASCII
+// except {}#%&$_-~^\|<>[]"'.
+static const uint8_t SAFE_CHARS[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
 static int S_render_node(cmark_renderer *renderer, cmark_node *node,
                          cmark_event_type ev_type, int options) {
   int list_number;
@@ -322,7 +340,7 @@ static int S_render_node(cmark_renderer *renderer, cmark_node *node,
     CR();
     LIT("\\begin{verbatim}");
     CR();
-    OUT(cmark_node_get_literal(node), false, LITERAL);
+    OUT_CHUNK(&node->as.code.literal, false, LITERAL);
     CR();
     LIT("\\end{verbatim}");
     BLANKLINE();
@@ -351,7 +369,7 @@ static int S_render_node(cmark_renderer *renderer, cmark_node *node,
     break;
 
   case CMARK_NODE_TEXT:
-    OUT(cmark_node_get_literal(node), allow_wrap, NORMAL);
+    OUT_CHUNK(&node->as.literal, allow_wrap, NORMAL);
     break;
 
   case CMARK_NODE_LINEBREAK:
@@ -372,7 +390,7 @@ static int S_render_node(cmark_renderer *renderer, cmark_node *node,
 
   case CMARK_NODE_CODE:
     LIT("\\texttt{");
-    OUT(cmark_node_get_literal(node), false, NORMAL);
+    OUT_CHUNK(&node->as.literal, false, NORMAL);
     LIT("}");
     break;
 
@@ -464,5 +482,12 @@ char *cmark_render_latex(cmark_node *root, int options, int width) {
 }
 
 char *cmark_render_latex_with_mem(cmark_node *root, int options, int width, cmark_mem *mem) {
-  return cmark_render(mem, root, options, width, outc, S_render_node);
+  return cmark_render(mem, root, options, width, outc, SAFE_CHARS,
+                      S_render_node);
+}
+
+int cmark_render_latex_to_writer(cmark_node *root, int options, int width,
+                                 cmark_write_func write, void *user_data) {
+  return cmark_render_to_writer(root, options, width, outc, SAFE_CHARS,
+                                S_render_node, write, user_data);
 }
@@ -68,6 +68,11 @@ void print_usage() {
   printf("  --version        Print version\n");
 }
 
+static int write_stdout(const char *data, size_t len, void *user_data) {
+  (void)user_data;
+  return fwrite(data, 1, len, stdout) == len ? 0 : -1;
+}
+
 static bool print_document(cmark_node *document, writer_format writer,
                            int options, int width, cmark_parser *parser) {
   char *result;
@@ -76,23 +81,24 @@ static bool print_document(cmark_node *document, writer_format writer,
 
   switch (writer) {
   case FORMAT_HTML:
-    result = cmark_render_html_with_mem(document, options, parser->syntax_extensions, mem);
-    break;
+    return cmark_render_html_to_writer(document, options,
+                                       parser->syntax_extensions, write_stdout,
+                                       NULL) != 0;
   case FORMAT_XML:
     result = cmark_render_xml_with_mem(document, options, mem);
     break;
   case FORMAT_MAN:
-    result = cmark_render_man_with_mem(document, options, width, mem);
-    break;
+    return cmark_render_man_to_writer(document, options, width,
+                                      write_stdout, NULL) != 0;
   case FORMAT_COMMONMARK:
-    result = cmark_render_commonmark_with_mem(document, options, width, mem);
-    break;
+    return cmark_render_commonmark_to_writer(document, options, width,
+                                             write_stdout, NULL) != 0;
   case FORMAT_PLAINTEXT:
-    result = cmark_render_plaintext_with_mem(document, options, width, mem);
-    break;
+    return cmark_render_plaintext_to_writer(document, options, width,
+                                            write_stdout, NULL) != 0;
   case FORMAT_LATEX:
-    result = cmark_render_latex_with_mem(document, options, width, mem);
-    break;
+    return cmark_render_latex_to_writer(document, options, width,
+                                        write_stdout, NULL) != 0;
   default:
     fprintf(stderr, "Unknown format %d\n", writer);
     return false;
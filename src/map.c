@@ -1,14 +1,59 @@
 #include "map.h"
 #include "utf8.h"
 #include "parser.h"
+#include "cmark_ctype.h"
+
+#define MAP_MIN_CAPACITY 16
 
 // normalize map label:  collapse internal whitespace to single space,
-// remove leading/trailing whitespace, case fold
+// remove leading/trailing whitespace, case fold.  Writes the result to
+// 'out' (which is cleared first) and returns false if the label is
+// actually empty (i.e. composed solely from whitespace).
+static bool S_normalize_label(cmark_strbuf *out, const unsigned char *data,
+                              bufsize_t len) {
+  bufsize_t i;
+  bool space = false;
+
+  cmark_strbuf_clear(out);
+
+  for (i = 0; i < len; ++i) {
+    if (data[i] >= 0x80)
+      break;
+  }
+
+  if (i < len) {
+    cmark_utf8proc_case_fold(out, data, len);
+    cmark_strbuf_trim(out);
+    cmark_strbuf_normalize_whitespace(out);
+    return out->size > 0 && out->ptr[0] != '\0';
+  }
+
+  // ASCII only: the only case folding required is A-Z, so fold, trim and
+  // collapse whitespace in a single pass.
+  cmark_strbuf_grow(out, len);
+  for (i = 0; i < len; ++i) {
+    unsigned char c = data[i];
+    if (cmark_isspace(c)) {
+      space = out->size > 0;
+      continue;
+    }
+    if (space) {
+      out->ptr[out->size++] = ' ';
+      space = false;
+    }
+    if (c >= 'A' && c <= 'Z')
+      c += 'a' - 'A';
+    out->ptr[out->size++] = c;
+  }
+  out->ptr[out->size] = '\0';
+
+  return out->size > 0 && out->ptr[0] != '\0';
+}
+
 // Return NULL if the label is actually empty (i.e. composed solely from
 // whitespace)
 unsigned char *normalize_map_label(cmark_mem *mem, cmark_chunk *ref) {
   cmark_strbuf normalized = CMARK_BUF_INIT(mem);
-  unsigned char *result;
 
   if (ref == NULL)
     return NULL;
@@ -16,65 +61,87 @@ unsigned char *normalize_map_label(cmark_mem *mem, cmark_chunk *ref) {
   if (ref->len == 0)
     return NULL;
 
-  cmark_utf8proc_case_fold(&normalized, ref->data, ref->len);
-  cmark_strbuf_trim(&normalized);
-  cmark_strbuf_normalize_whitespace(&normalized);
-
-  result = cmark_strbuf_detach(&normalized);
-  assert(result);
-
-  if (result[0] == '\0') {
-    mem->free(result);
+  if (!S_normalize_label(&normalized, ref->data, ref->len)) {
+    cmark_strbuf_free(&normalized);
     return NULL;
   }
 
-  return result;
+  return cmark_strbuf_detach(&normalized);
 }
 
-static int
-labelcmp(const unsigned char *a, const unsigned char *b) {
-  return strcmp((const char *)a, (const char *)b);
-}
+// Seeded FNV-1a with a final avalanche step.  The seed differs between
+// maps (and between runs, thanks to ASLR), so inputs crafted to collide
+// for one map don't degrade lookups into linear scans.
+static uint32_t S_hash_label(const unsigned char *label, uint32_t seed) {
+  uint32_t h = 2166136261u ^ seed;
 
-static int
-refcmp(const void *p1, const void *p2) {
-  cmark_map_entry *r1 = *(cmark_map_entry **)p1;
-  cmark_map_entry *r2 = *(cmark_map_entry **)p2;
-  int res = labelcmp(r1->label, r2->label);
-  return res ? res : ((int)r1->age - (int)r2->age);
+  while (*label) {
+    h ^= *label++;
+    h *= 16777619u;
+  }
+
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
 }
 
-static int
-refsearch(const void *label, const void *p2) {
-  cmark_map_entry *ref = *(cmark_map_entry **)p2;
-  return labelcmp((const unsigned char *)label, ref->label);
+static cmark_map_entry **S_find_slot(cmark_map *map, const unsigned char *label,
+                                     uint32_t hash) {
+  size_t mask = map->capacity - 1;
+  size_t i = hash & mask;
+  cmark_map_entry *entry;
+
+  while ((entry = map->table[i]) != NULL) {
+    if (entry->hash == hash &&
+        strcmp((const char *)entry->label, (const char *)label) == 0)
+      break;
+    i = (i + 1) & mask;
+  }
+
+  return &map->table[i];
 }
 
-static void sort_map(cmark_map *map) {
-  size_t i = 0, last = 0, size = map->size;
-  cmark_map_entry *r = map->refs, **sorted = NULL;
+static void S_grow_table(cmark_map *map) {
+  cmark_map_entry **old = map->table;
+  size_t old_capacity = map->capacity, i;
+
+  map->capacity = old_capacity ? old_capacity * 2 : MAP_MIN_CAPACITY;
+  map->table = (cmark_map_entry **)map->mem->calloc(map->capacity,
+                                                    sizeof(cmark_map_entry *));
 
-  sorted = (cmark_map_entry **)map->mem->calloc(size, sizeof(cmark_map_entry *));
-  while (r) {
-    sorted[i++] = r;
-    r = r->next;
+  for (i = 0; i < old_capacity; ++i) {
+    if (old[i])
+      *S_find_slot(map, old[i]->label, old[i]->hash) = old[i];
   }
 
-  qsort(sorted, size, sizeof(cmark_map_entry *), refcmp);
+  map->mem->free(old);
+}
+
+// Takes ownership of 'entry', whose label must already be normalized.
+// If the label is already present, the earlier entry keeps precedence.
+void cmark_map_add(cmark_map *map, cmark_map_entry *entry) {
+  cmark_map_entry **slot;
 
-  for (i = 1; i < size; i++) {
-    if (labelcmp(sorted[i]->label, sorted[last]->label) != 0)
-      sorted[++last] = sorted[i];
-  }
+  entry->next = map->refs;
+  map->refs = entry;
+
+  if ((map->size + 1) * 2 > map->capacity)
+    S_grow_table(map);
 
-  map->sorted = sorted;
-  map->size = last + 1;
+  entry->hash = S_hash_label(entry->label, map->seed);
+  slot = S_find_slot(map, entry->label, entry->hash);
+  if (*slot == NULL) {
+    *slot = entry;
+    map->size++;
+  }
 }
 
 cmark_map_entry *cmark_map_lookup(cmark_map *map, cmark_chunk *label) {
-  cmark_map_entry **ref = NULL;
   cmark_map_entry *r = NULL;
-  unsigned char *norm;
+  const unsigned char *norm;
 
   if (label->len < 1 || label->len > MAX_LINK_LABEL_LENGTH)
     return NULL;
@@ -82,18 +149,13 @@ cmark_map_entry *cmark_map_lookup(cmark_map *map, cmark_chunk *label) {
   if (map == NULL || !map->size)
     return NULL;
 
-  norm = normalize_map_label(map->mem, label);
-  if (norm == NULL)
+  if (!S_normalize_label(&map->scratch, label->data, label->len))
     return NULL;
 
-  if (!map->sorted)
-    sort_map(map);
-
-  ref = (cmark_map_entry **)bsearch(norm, map->sorted, map->size, sizeof(cmark_map_entry *), refsearch);
-  map->mem->free(norm);
+  norm = map->scratch.ptr;
+  r = *S_find_slot(map, norm, S_hash_label(norm, map->seed));
 
-  if (ref != NULL) {
-    r = ref[0];
+  if (r != NULL) {
     /* Check for expansion limit */
     if (r->size > map->max_ref_size - map->ref_size)
       return NULL;
@@ -116,14 +178,20 @@ void cmark_map_free(cmark_map *map) {
     ref = next;
   }
 
-  map->mem->free(map->sorted);
+  cmark_strbuf_free(&map->scratch);
+  map->mem->free(map->table);
   map->mem->free(map);
 }
 
 cmark_map *cmark_map_new(cmark_mem *mem, cmark_map_free_f free) {
   cmark_map *map = (cmark_map *)mem->calloc(1, sizeof(cmark_map));
+  static const char seed_anchor;
+  uintptr_t addr = (uintptr_t)map ^ (uintptr_t)&seed_anchor;
+
   map->mem = mem;
   map->free = free;
   map->max_ref_size = UINT_MAX;
+  map->seed = (uint32_t)(addr ^ (addr >> 16 >> 16) ^ (addr >> 4));
+  cmark_strbuf_init(mem, &map->scratch, 0);
   return map;
 }
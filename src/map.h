@@ -2,6 +2,7 @@
 #define CMARK_MAP_H
 
 #include "chunk.h"
+#include "buffer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -10,7 +11,7 @@ extern "C" {
 struct cmark_map_entry {
   struct cmark_map_entry *next;
   unsigned char *label;
-  size_t age;
+  uint32_t hash;
   size_t size;
 };
 
@@ -22,11 +23,18 @@ typedef void (*cmark_map_free_f)(struct cmark_map *, cmark_map_entry *);
 
 struct cmark_map {
   cmark_mem *mem;
+  /* Every entry ever added, including shadowed duplicates, newest first */
   cmark_map_entry *refs;
-  cmark_map_entry **sorted;
+  /* Open-addressing table holding the first entry for each label */
+  cmark_map_entry **table;
+  size_t capacity;
+  /* Number of distinct labels in 'table' */
   size_t size;
   size_t ref_size;
   size_t max_ref_size;
+  uint32_t seed;
+  /* Scratch space for normalizing labels on lookup */
+  cmark_strbuf scratch;
   cmark_map_free_f free;
 };
 
@@ -35,6 +43,7 @@ typedef struct cmark_map cmark_map;
 unsigned char *normalize_map_label(cmark_mem *mem, cmark_chunk *ref);
 cmark_map *cmark_map_new(cmark_mem *mem, cmark_map_free_f free);
 void cmark_map_free(cmark_map *map);
+void cmark_map_add(cmark_map *map, cmark_map_entry *entry);
 cmark_map_entry *cmark_map_lookup(cmark_map *map, cmark_chunk *label);
 
 #ifdef __cplusplus
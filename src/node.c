@@ -824,6 +824,13 @@ int cmark_node_get_end_column(cmark_node *node) {
   return node->end_column;
 }
 
+int cmark_node_get_truncated(cmark_node *node) {
+  if (node == NULL || node->type != CMARK_NODE_DOCUMENT) {
+    return 0;
+  }
+  return (node->flags & CMARK_NODE__TRUNCATED) != 0;
+}
+
 // Unlink a node without adjusting its next, prev, and parent pointers.
 static void S_node_unlink(cmark_node *node) {
   if (node == NULL) {
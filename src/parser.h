@@ -5,6 +5,7 @@
 #include "references.h"
 #include "node.h"
 #include "buffer.h"
+#include "scratch.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,6 +13,45 @@ extern "C" {
 
 #define MAX_LINK_LABEL_LENGTH 1000
 
+/* Per-byte dispatch of inline syntax extensions, rebuilt whenever an
+ * extension is attached to the parser. */
+typedef struct cmark_inline_dispatch {
+  /* The extensions whose 'match_inline' is tried for byte 'c' are
+   * exts[start[c]] .. exts[start[c + 1] - 1], in attachment order.
+   * Extensions that don't declare any special inline characters are
+   * tried for every byte. */
+  cmark_syntax_extension **exts;
+  uint16_t start[257];
+  /* The first extension that declared 'c' as a special inline character */
+  cmark_syntax_extension *owner[256];
+} cmark_inline_dispatch;
+
+/* Delimiter and bracket structs released during inline parsing, kept on
+ * free lists (linked through 'previous') for reuse by later paragraphs
+ * instead of being freed one at a time. */
+typedef struct cmark_inline_pool {
+  struct delimiter *delimiters;
+  struct bracket *brackets;
+} cmark_inline_pool;
+
+/* A growable array of nodes recorded while parsing. */
+typedef struct cmark_node_list {
+  struct cmark_node **items;
+  bufsize_t size;
+  bufsize_t asize;
+} cmark_node_list;
+
+static CMARK_INLINE void cmark_node_list_append(cmark_mem *mem,
+                                                cmark_node_list *list,
+                                                struct cmark_node *node) {
+  if (list->size == list->asize) {
+    list->asize = list->asize ? list->asize * 2 : 16;
+    list->items = (struct cmark_node **)mem->realloc(
+        list->items, list->asize * sizeof(struct cmark_node *));
+  }
+  list->items[list->size++] = node;
+}
+
 struct cmark_parser {
   struct cmark_mem *mem;
   /* A hashtable of urls in the current document for cross-references */
@@ -49,7 +89,34 @@ struct cmark_parser {
   size_t total_size;
   cmark_llist *syntax_extensions;
   cmark_llist *inline_syntax_extensions;
+  cmark_inline_dispatch *inline_dispatch;
+  /* Preserved across resets, released by cmark_parser_free() */
+  cmark_inline_pool inline_pool;
+  /* See the documentation for cmark_parser_scratch_alloc() in
+   * cmark-gfm-extension_api.h. Preserved across resets. */
+  cmark_scratch scratch;
+  /* Non-zero for the bytes that may start a block as the first
+   * non-space character of a line that isn't indented */
+  uint8_t block_start_chars[256];
   cmark_ispunct_func backslash_ispunct;
+  /* See the documentation for cmark_parser_set_max_blocks() in cmark.h.
+   * Preserved across resets, like 'options'. */
+  int max_blocks;
+  /* See the documentation for
+   * cmark_gfm_extensions_set_table_max_autocompleted_cells() in
+   * cmark-gfm-core-extensions.h; negative until it is set.  Preserved
+   * across resets, like 'max_blocks'. */
+  int table_max_autocompleted_cells;
+  /* Number of blocks finalized and kept directly under 'root' so far */
+  int n_top_level_blocks;
+  /* Set once 'max_blocks' was exceeded; further input is ignored */
+  bool truncated;
+  /* With CMARK_OPT_FOOTNOTES, the footnote definitions in the order they
+   * were closed and the footnote references in document order, for
+   * resolving footnotes without walking the tree.  The arrays are
+   * preserved across resets. */
+  cmark_node_list footnote_defs;
+  cmark_node_list footnote_refs;
 };
 
 #ifdef __cplusplus
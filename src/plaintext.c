@@ -3,6 +3,9 @@
 #include "render.h"
 
 #define OUT(s, wrap, escaping) renderer->out(renderer, node, s, wrap, escaping)
+#define OUT_CHUNK(c, wrap, escaping)                                           \
+  renderer->out_len(renderer, node, (const char *)(c)->data, (c)->len, wrap,   \
+                    escaping)
 #define LIT(s) renderer->out(renderer, node, s, false, LITERAL)
 #define CR() renderer->cr(renderer)
 #define BLANKLINE() renderer->blankline(renderer)
@@ -16,6 +19,20 @@ static CMARK_INLINE void outc(cmark_renderer *renderer, cmark_node *node,
   cmark_render_code_point(renderer, c);
 }
 
+// The bytes outc writes out unchanged, for cmark_render: printable ASCII.
+static const uint8_t SAFE_CHARS[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
 static int S_render_node(cmark_renderer *renderer, cmark_node *node,
                          cmark_event_type ev_type, int options) {
   int list_number;
@@ -112,7 +129,7 @@ static int S_render_node(cmark_renderer *renderer, cmark_node *node,
     if (!first_in_list_item) {
       BLANKLINE();
     }
-    OUT(cmark_node_get_literal(node), false, LITERAL);
+    OUT_CHUNK(&node->as.code.literal, false, LITERAL);
     BLANKLINE();
     break;
 
@@ -133,7 +150,7 @@ static int S_render_node(cmark_renderer *renderer, cmark_node *node,
     break;
 
   case CMARK_NODE_TEXT:
-    OUT(cmark_node_get_literal(node), allow_wrap, NORMAL);
+    OUT_CHUNK(&node->as.literal, allow_wrap, NORMAL);
     break;
 
   case CMARK_NODE_LINEBREAK:
@@ -153,7 +170,7 @@ static int S_render_node(cmark_renderer *renderer, cmark_node *node,
     break;
 
   case CMARK_NODE_CODE:
-    OUT(cmark_node_get_literal(node), allow_wrap, LITERAL);
+    OUT_CHUNK(&node->as.literal, allow_wrap, LITERAL);
     break;
 
   case CMARK_NODE_HTML_INLINE:
@@ -214,5 +231,16 @@ char *cmark_render_plaintext_with_mem(cmark_node *root, int options, int width,
     // a different meaning with OPT_HARDBREAKS
     width = 0;
   }
-  return cmark_render(mem, root, options, width, outc, S_render_node);
+  return cmark_render(mem, root, options, width, outc, SAFE_CHARS,
+                      S_render_node);
+}
+
+int cmark_render_plaintext_to_writer(cmark_node *root, int options, int width,
+                                     cmark_write_func write, void *user_data) {
+  if (options & CMARK_OPT_HARDBREAKS) {
+    // see cmark_render_plaintext_with_mem
+    width = 0;
+  }
+  return cmark_render_to_writer(root, options, width, outc, SAFE_CHARS,
+                                S_render_node, write, user_data);
 }
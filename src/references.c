@@ -24,18 +24,13 @@ void cmark_reference_create(cmark_map *map, cmark_chunk *label,
   if (reflabel == NULL)
     return;
 
-  assert(map->sorted == NULL);
-
   ref = (cmark_reference *)map->mem->calloc(1, sizeof(*ref));
   ref->entry.label = reflabel;
   ref->url = cmark_clean_url(map->mem, url);
   ref->title = cmark_clean_title(map->mem, title);
-  ref->entry.age = map->size;
-  ref->entry.next = map->refs;
   ref->entry.size = ref->url.len + ref->title.len;
 
-  map->refs = (cmark_map_entry *)ref;
-  map->size++;
+  cmark_map_add(map, &ref->entry);
 }
 
 cmark_map *cmark_reference_map_new(cmark_mem *mem) {
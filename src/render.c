@@ -5,6 +5,7 @@
 #include "utf8.h"
 #include "render.h"
 #include "node.h"
+#include "iterator.h"
 #include "syntax_extension.h"
 
 static CMARK_INLINE void S_cr(cmark_renderer *renderer) {
@@ -19,24 +20,77 @@ static CMARK_INLINE void S_blankline(cmark_renderer *renderer) {
   }
 }
 
-static void S_out(cmark_renderer *renderer, cmark_node *node,
-                  const char *source, bool wrap,
-                  cmark_escaping escape) {
-  int length = (int)strlen(source);
+// Every printable ASCII byte, for LITERAL escaping.
+static const uint8_t LITERAL_SAFE_CHARS[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+// Breaks the current line at last_breakable: the space there becomes a
+// newline and the prefix goes in after it, moving the rest of the line up
+// in place.
+static void S_wrap(cmark_renderer *renderer) {
+  cmark_strbuf *buf = renderer->buffer;
+  cmark_strbuf *prefix = renderer->prefix;
+  bufsize_t at = renderer->last_breakable;
+  bufsize_t rest = buf->size - at - 1;
+
+  cmark_strbuf_grow(buf, buf->size + prefix->size);
+  memmove(buf->ptr + at + 1 + prefix->size, buf->ptr + at + 1, rest);
+  buf->ptr[at] = '\n';
+  memcpy(buf->ptr + at + 1, prefix->ptr, prefix->size);
+  buf->size += prefix->size;
+  buf->ptr[buf->size] = '\0';
+
+  renderer->column = prefix->size + rest;
+  renderer->last_breakable = 0;
+  renderer->begin_line = false;
+  renderer->begin_content = false;
+}
+
+static void S_out_len(cmark_renderer *renderer, cmark_node *node,
+                      const char *source, bufsize_t length, bool wrap,
+                      cmark_escaping escape) {
   unsigned char nextc;
   int32_t c;
-  int i = 0;
+  bufsize_t i = 0, run;
   int last_nonspace;
   int len;
-  cmark_chunk remainder = cmark_chunk_literal("");
   int k = renderer->buffer->size - 1;
+  const uint8_t *safe = NULL;
+  uint8_t safe_mask;
 
   cmark_syntax_extension *ext = node->ancestor_extension;
   if (ext && !ext->commonmark_escape_func)
     ext = NULL;
 
+  // Text the parser found to be ASCII needs no UTF-8 decoding.
+  bool ascii = (node->type == CMARK_NODE_TEXT ||
+                node->type == CMARK_NODE_CODE) &&
+               source == (const char *)node->as.literal.data &&
+               (node->as.literal.flags & CMARK_CHUNK_ASCII);
+
   wrap = wrap && !renderer->no_linebreaks;
 
+  // Runs of bytes written out unchanged are copied in one go, except where
+  // an extension gets to escape each character.  Spaces end a run when
+  // wrapping, since lines may be broken there.
+  if (!ext) {
+    if (escape == LITERAL)
+      safe = LITERAL_SAFE_CHARS;
+    else if (escape == NORMAL)
+      safe = renderer->safe_chars;
+  }
+  safe_mask = wrap ? 1 : 3;
+
   if (renderer->in_tight_list_item && renderer->need_cr > 1) {
     renderer->need_cr = 1;
   }
@@ -58,6 +112,21 @@ static void S_out(cmark_renderer *renderer, cmark_node *node,
   }
 
   while (i < length) {
+    if (safe && !renderer->begin_line && !renderer->begin_content &&
+        (safe[(uint8_t)source[i]] & safe_mask)) {
+      run = i + 1;
+      while (run < length && (safe[(uint8_t)source[run]] & safe_mask))
+        run++;
+      cmark_strbuf_put(renderer->buffer, (const unsigned char *)source + i,
+                       run - i);
+      renderer->column += run - i;
+      i = run;
+      if (renderer->width > 0 && renderer->column > renderer->width &&
+          renderer->last_breakable > 0)
+        S_wrap(renderer);
+      continue;
+    }
+
     if (renderer->begin_line) {
       cmark_strbuf_put(renderer->buffer, renderer->prefix->ptr,
                        renderer->prefix->size);
@@ -65,15 +134,20 @@ static void S_out(cmark_renderer *renderer, cmark_node *node,
       renderer->column = renderer->prefix->size;
     }
 
-    len = cmark_utf8proc_iterate((const uint8_t *)source + i, length - i, &c);
-    if (len == -1) { // error condition
-      return;        // return without rendering rest of string
+    if (ascii) {
+      c = (unsigned char)source[i];
+      len = 1;
+    } else {
+      len = cmark_utf8proc_iterate((const uint8_t *)source + i, length - i, &c);
+      if (len == -1) { // error condition
+        return;        // return without rendering rest of string
+      }
     }
 
     if (ext && ext->commonmark_escape_func(ext, node, c))
       cmark_strbuf_putc(renderer->buffer, '\\');
 
-    nextc = source[i + len];
+    nextc = i + len < length ? source[i + len] : 0;
     if (c == 32 && wrap) {
       if (!renderer->begin_line) {
         last_nonspace = renderer->buffer->size;
@@ -82,12 +156,12 @@ static void S_out(cmark_renderer *renderer, cmark_node *node,
         renderer->begin_line = false;
         renderer->begin_content = false;
         // skip following spaces
-        while (source[i + 1] == ' ') {
+        while (i + 1 < length && source[i + 1] == ' ') {
           i++;
         }
         // We don't allow breaks that make a digit the first character
         // because this causes problems with commonmark output.
-        if (!cmark_isdigit(source[i + 1])) {
+        if (i + 1 >= length || !cmark_isdigit(source[i + 1])) {
           renderer->last_breakable = last_nonspace;
         }
       }
@@ -120,29 +194,19 @@ static void S_out(cmark_renderer *renderer, cmark_node *node,
     // earlier place where the line could be broken:
     if (renderer->width > 0 && renderer->column > renderer->width &&
         !renderer->begin_line && renderer->last_breakable > 0) {
-
-      // copy from last_breakable to remainder
-      cmark_chunk_set_cstr(renderer->mem, &remainder,
-                           (char *)renderer->buffer->ptr +
-                               renderer->last_breakable + 1);
-      // truncate at last_breakable
-      cmark_strbuf_truncate(renderer->buffer, renderer->last_breakable);
-      // add newline, prefix, and remainder
-      cmark_strbuf_putc(renderer->buffer, '\n');
-      cmark_strbuf_put(renderer->buffer, renderer->prefix->ptr,
-                       renderer->prefix->size);
-      cmark_strbuf_put(renderer->buffer, remainder.data, remainder.len);
-      renderer->column = renderer->prefix->size + remainder.len;
-      cmark_chunk_free(renderer->mem, &remainder);
-      renderer->last_breakable = 0;
-      renderer->begin_line = false;
-      renderer->begin_content = false;
+      S_wrap(renderer);
     }
 
     i += len;
   }
 }
 
+static void S_out(cmark_renderer *renderer, cmark_node *node,
+                  const char *source, bool wrap,
+                  cmark_escaping escape) {
+  S_out_len(renderer, node, source, (bufsize_t)strlen(source), wrap, escape);
+}
+
 // Assumes no newlines, assumes ascii content:
 void cmark_render_ascii(cmark_renderer *renderer, const char *s) {
   int origsize = renderer->buffer->size;
@@ -155,27 +219,57 @@ void cmark_render_code_point(cmark_renderer *renderer, uint32_t c) {
   renderer->column += 1;
 }
 
-char *cmark_render(cmark_mem *mem, cmark_node *root, int options, int width,
-                   void (*outc)(cmark_renderer *, cmark_node *,
-                                cmark_escaping, int32_t,
-                                unsigned char),
-                   int (*render_node)(cmark_renderer *renderer,
-                                      cmark_node *node,
-                                      cmark_event_type ev_type, int options)) {
+// Passes the start of the buffer to 'write', keeping back what S_out may
+// still need to look at: the last two bytes, which tell it how many line
+// endings are already there, and when wrapping, everything from the
+// last place the current line could be broken.
+static bool S_flush(cmark_renderer *renderer, cmark_write_func write,
+                    void *user_data) {
+  cmark_strbuf *buf = renderer->buffer;
+  bufsize_t keep = buf->size - 2;
+
+  // last_breakable 0 means there is none, so leave a byte before it.
+  if (renderer->width > 0 && renderer->last_breakable > 0 &&
+      renderer->last_breakable - 1 < keep)
+    keep = renderer->last_breakable - 1;
+  if (keep <= 0)
+    return true;
+
+  if (write((const char *)buf->ptr, (size_t)keep, user_data) != 0)
+    return false;
+  cmark_strbuf_drop(buf, keep);
+  if (renderer->last_breakable > 0)
+    renderer->last_breakable -= keep;
+  return true;
+}
+
+// Renders 'root' into 'buf'.  If 'write' is not NULL, finished output is
+// passed to it whenever CMARK_WRITER_CHUNK bytes have built up, and 'buf'
+// holds the unwritten rest on return.  Returns false if 'write' failed.
+static bool S_render(cmark_strbuf *buf, cmark_node *root, int options,
+                     int width,
+                     void (*outc)(cmark_renderer *, cmark_node *,
+                                  cmark_escaping, int32_t, unsigned char),
+                     const uint8_t *safe_chars,
+                     int (*render_node)(cmark_renderer *renderer,
+                                        cmark_node *node,
+                                        cmark_event_type ev_type, int options),
+                     cmark_write_func write, void *user_data) {
+  cmark_mem *mem = buf->mem;
   cmark_strbuf pref = CMARK_BUF_INIT(mem);
-  cmark_strbuf buf = CMARK_BUF_INIT(mem);
   cmark_node *cur;
   cmark_event_type ev_type;
-  char *result;
-  cmark_iter *iter = cmark_iter_new(root);
+  cmark_iter_storage storage;
+  cmark_iter *iter = cmark_iter_init(&storage, root);
+  bool ok = true;
 
-  cmark_renderer renderer = {mem,   &buf, &pref, 0,           width,
-                             0,     0,    true,  true,        false,
-                             false, outc, S_cr,  S_blankline, S_out,
-                             0};
+  cmark_renderer renderer = {mem,   buf,   &pref, 0,           width,
+                             0,     0,     true,  true,        false,
+                             false, outc,  S_cr,  S_blankline, S_out,
+                             0,     S_out_len, safe_chars};
 
-  while ((ev_type = cmark_iter_next(iter)) != CMARK_EVENT_DONE) {
-    cur = cmark_iter_get_node(iter);
+  while ((ev_type = cmark_iter_step(iter)) != CMARK_EVENT_DONE) {
+    cur = iter->cur.node;
     if (cur->extension) {
       cur->ancestor_extension = cur->extension;
     } else if (cur->parent) {
@@ -196,18 +290,51 @@ char *cmark_render(cmark_mem *mem, cmark_node *root, int options, int width,
       // autolinks.
       cmark_iter_reset(iter, cur, CMARK_EVENT_EXIT);
     }
+    if (write && buf->size >= CMARK_WRITER_CHUNK &&
+        !(ok = S_flush(&renderer, write, user_data)))
+      break;
   }
 
   // ensure final newline
-  if (renderer.buffer->size == 0 || renderer.buffer->ptr[renderer.buffer->size - 1] != '\n') {
-    cmark_strbuf_putc(renderer.buffer, '\n');
+  if (ok && (buf->size == 0 || buf->ptr[buf->size - 1] != '\n')) {
+    cmark_strbuf_putc(buf, '\n');
   }
 
-  result = (char *)cmark_strbuf_detach(renderer.buffer);
+  cmark_strbuf_free(&pref);
+
+  return ok;
+}
+
+char *cmark_render(cmark_mem *mem, cmark_node *root, int options, int width,
+                   void (*outc)(cmark_renderer *, cmark_node *,
+                                cmark_escaping, int32_t,
+                                unsigned char),
+                   const uint8_t *safe_chars,
+                   int (*render_node)(cmark_renderer *renderer,
+                                      cmark_node *node,
+                                      cmark_event_type ev_type, int options)) {
+  cmark_strbuf buf = CMARK_BUF_INIT(mem);
+
+  S_render(&buf, root, options, width, outc, safe_chars, render_node, NULL,
+           NULL);
+  return (char *)cmark_strbuf_detach(&buf);
+}
 
-  cmark_iter_free(iter);
-  cmark_strbuf_free(renderer.prefix);
-  cmark_strbuf_free(renderer.buffer);
+int cmark_render_to_writer(
+    cmark_node *root, int options, int width,
+    void (*outc)(cmark_renderer *, cmark_node *, cmark_escaping, int32_t,
+                 unsigned char),
+    const uint8_t *safe_chars,
+    int (*render_node)(cmark_renderer *renderer, cmark_node *node,
+                       cmark_event_type ev_type, int options),
+    cmark_write_func write, void *user_data) {
+  cmark_strbuf buf = CMARK_BUF_INIT(cmark_node_mem(root));
+  bool ok;
 
-  return result;
+  cmark_strbuf_grow(&buf, CMARK_WRITER_CHUNK);
+  ok = S_render(&buf, root, options, width, outc, safe_chars, render_node,
+                write, user_data) &&
+       write((const char *)buf.ptr, (size_t)buf.size, user_data) == 0;
+  cmark_strbuf_free(&buf);
+  return ok;
 }
@@ -28,6 +28,10 @@ struct cmark_renderer {
   void (*blankline)(struct cmark_renderer *);
   void (*out)(struct cmark_renderer *, cmark_node *, const char *, bool, cmark_escaping);
   unsigned int footnote_ix;
+  // As for 'out', but for 'len' bytes that need not be NUL-terminated.
+  void (*out_len)(struct cmark_renderer *, cmark_node *, const char *,
+                  bufsize_t, bool, cmark_escaping);
+  const uint8_t *safe_chars;
 };
 
 typedef struct cmark_renderer cmark_renderer;
@@ -39,22 +43,49 @@ struct cmark_html_renderer {
   unsigned int footnote_ix;
   unsigned int written_footnote_ix;
   void *opaque;
+  cmark_llist *filter_tag_extensions;
+  struct cmark_html_tag_matcher *tag_matcher;
+  cmark_html_segments *segments;
+  // Output budget of an excerpt, 0 if none, and whether it ran out
+  size_t max_len;
+  bool stopped;
 };
 
 typedef struct cmark_html_renderer cmark_html_renderer;
 
+// How much output the '_to_writer' renderers collect before handing it on.
+// Output is only passed on between nodes, so the buffer may grow beyond
+// this while a single node is rendered.
+#define CMARK_WRITER_CHUNK (16 * 1024)
+
 void cmark_render_ascii(cmark_renderer *renderer, const char *s);
 
 void cmark_render_code_point(cmark_renderer *renderer, uint32_t c);
 
+// 'safe_chars' maps each byte to 1 if 'outc' writes it out unchanged for
+// NORMAL escaping whenever neither begin_line nor begin_content is set,
+// to 2 for the space, which must be safe in that sense too, and to 0
+// otherwise.  Runs of safe bytes are copied without calling 'outc'.
 char *cmark_render(cmark_mem *mem, cmark_node *root, int options, int width,
                    void (*outc)(cmark_renderer *, cmark_node *,
                                 cmark_escaping, int32_t,
                                 unsigned char),
+                   const uint8_t *safe_chars,
                    int (*render_node)(cmark_renderer *renderer,
                                       cmark_node *node,
                                       cmark_event_type ev_type, int options));
 
+// As for cmark_render, but passes the output to 'write' in pieces.
+// Returns 1 on success and 0 if 'write' failed.
+int cmark_render_to_writer(
+    cmark_node *root, int options, int width,
+    void (*outc)(cmark_renderer *, cmark_node *, cmark_escaping, int32_t,
+                 unsigned char),
+    const uint8_t *safe_chars,
+    int (*render_node)(cmark_renderer *renderer, cmark_node *node,
+                       cmark_event_type ev_type, int options),
+    cmark_write_func write, void *user_data);
+
 #ifdef __cplusplus
 }
 #endif
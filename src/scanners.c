@@ -8846,2490 +8846,6 @@ bufsize_t _scan_html_block_start_7(const unsigned char *p) {
   }
 }
 
-// Try to match an HTML block end line of type 1
-bufsize_t _scan_html_block_end_1(const unsigned char *p) {
-  const unsigned char *marker = NULL;
-  const unsigned char *start = p;
-
-  {
-    unsigned char yych;
-    unsigned int yyaccept = 0;
-    static const unsigned char yybm[] = {
-        0,  64, 64, 64, 64, 64, 64,  64, 64, 64, 0,  64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 128, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,
-    };
-    yych = *p;
-    if (yych <= 0xDF) {
-      if (yych <= ';') {
-        if (yych <= 0x00)
-          goto yy499;
-        if (yych != '\n')
-          goto yy501;
-      } else {
-        if (yych <= '<')
-          goto yy502;
-        if (yych <= 0x7F)
-          goto yy501;
-        if (yych >= 0xC2)
-          goto yy503;
-      }
-    } else {
-      if (yych <= 0xEF) {
-        if (yych <= 0xE0)
-          goto yy504;
-        if (yych == 0xED)
-          goto yy506;
-        goto yy505;
-      } else {
-        if (yych <= 0xF0)
-          goto yy507;
-        if (yych <= 0xF3)
-          goto yy508;
-        if (yych <= 0xF4)
-          goto yy509;
-      }
-    }
-  yy499:
-    ++p;
-  yy500 : { return 0; }
-  yy501:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= '\n') {
-      if (yych <= 0x00)
-        goto yy500;
-      if (yych <= '\t')
-        goto yy511;
-      goto yy500;
-    } else {
-      if (yych <= 0x7F)
-        goto yy511;
-      if (yych <= 0xC1)
-        goto yy500;
-      if (yych <= 0xF4)
-        goto yy511;
-      goto yy500;
-    }
-  yy502:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= '.') {
-      if (yych <= 0x00)
-        goto yy500;
-      if (yych == '\n')
-        goto yy500;
-      goto yy511;
-    } else {
-      if (yych <= 0x7F) {
-        if (yych <= '/')
-          goto yy521;
-        goto yy511;
-      } else {
-        if (yych <= 0xC1)
-          goto yy500;
-        if (yych <= 0xF4)
-          goto yy511;
-        goto yy500;
-      }
-    }
-  yy503:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy500;
-    if (yych <= 0xBF)
-      goto yy510;
-    goto yy500;
-  yy504:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x9F)
-      goto yy500;
-    if (yych <= 0xBF)
-      goto yy514;
-    goto yy500;
-  yy505:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy500;
-    if (yych <= 0xBF)
-      goto yy514;
-    goto yy500;
-  yy506:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy500;
-    if (yych <= 0x9F)
-      goto yy514;
-    goto yy500;
-  yy507:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x8F)
-      goto yy500;
-    if (yych <= 0xBF)
-      goto yy516;
-    goto yy500;
-  yy508:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy500;
-    if (yych <= 0xBF)
-      goto yy516;
-    goto yy500;
-  yy509:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy500;
-    if (yych <= 0x8F)
-      goto yy516;
-    goto yy500;
-  yy510:
-    yych = *++p;
-  yy511:
-    if (yybm[0 + yych] & 64) {
-      goto yy510;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\n')
-          goto yy512;
-        if (yych <= '<')
-          goto yy513;
-      } else {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        goto yy516;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy517;
-        if (yych <= 0xEF)
-          goto yy516;
-        goto yy518;
-      } else {
-        if (yych <= 0xF3)
-          goto yy519;
-        if (yych <= 0xF4)
-          goto yy520;
-      }
-    }
-  yy512:
-    p = marker;
-    if (yyaccept == 0) {
-      goto yy500;
-    } else {
-      goto yy534;
-    }
-  yy513:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xDF) {
-      if (yych <= '.') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= '/')
-          goto yy521;
-        if (yych <= 0x7F)
-          goto yy510;
-        if (yych <= 0xC1)
-          goto yy512;
-      }
-    } else {
-      if (yych <= 0xEF) {
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych == 0xED)
-          goto yy517;
-        goto yy516;
-      } else {
-        if (yych <= 0xF0)
-          goto yy518;
-        if (yych <= 0xF3)
-          goto yy519;
-        if (yych <= 0xF4)
-          goto yy520;
-        goto yy512;
-      }
-    }
-  yy514:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy512;
-    if (yych <= 0xBF)
-      goto yy510;
-    goto yy512;
-  yy515:
-    yych = *++p;
-    if (yych <= 0x9F)
-      goto yy512;
-    if (yych <= 0xBF)
-      goto yy514;
-    goto yy512;
-  yy516:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy512;
-    if (yych <= 0xBF)
-      goto yy514;
-    goto yy512;
-  yy517:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy512;
-    if (yych <= 0x9F)
-      goto yy514;
-    goto yy512;
-  yy518:
-    yych = *++p;
-    if (yych <= 0x8F)
-      goto yy512;
-    if (yych <= 0xBF)
-      goto yy516;
-    goto yy512;
-  yy519:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy512;
-    if (yych <= 0xBF)
-      goto yy516;
-    goto yy512;
-  yy520:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy512;
-    if (yych <= 0x8F)
-      goto yy516;
-    goto yy512;
-  yy521:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 's') {
-      if (yych <= 'R') {
-        if (yych <= '\n') {
-          if (yych <= 0x00)
-            goto yy512;
-          if (yych <= '\t')
-            goto yy510;
-          goto yy512;
-        } else {
-          if (yych != 'P')
-            goto yy510;
-        }
-      } else {
-        if (yych <= 'o') {
-          if (yych <= 'S')
-            goto yy523;
-          if (yych <= 'T')
-            goto yy524;
-          goto yy510;
-        } else {
-          if (yych <= 'p')
-            goto yy522;
-          if (yych <= 'r')
-            goto yy510;
-          goto yy523;
-        }
-      }
-    } else {
-      if (yych <= 0xEC) {
-        if (yych <= 0xC1) {
-          if (yych <= 't')
-            goto yy524;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        } else {
-          if (yych <= 0xDF)
-            goto yy514;
-          if (yych <= 0xE0)
-            goto yy515;
-          goto yy516;
-        }
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xED)
-            goto yy517;
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy522:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'Q') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 'q') {
-          if (yych <= 'R')
-            goto yy525;
-          goto yy510;
-        } else {
-          if (yych <= 'r')
-            goto yy525;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy523:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 't') {
-      if (yych <= 'C') {
-        if (yych <= '\t') {
-          if (yych <= 0x00)
-            goto yy512;
-          goto yy510;
-        } else {
-          if (yych <= '\n')
-            goto yy512;
-          if (yych <= 'B')
-            goto yy510;
-          goto yy526;
-        }
-      } else {
-        if (yych <= 'b') {
-          if (yych == 'T')
-            goto yy527;
-          goto yy510;
-        } else {
-          if (yych <= 'c')
-            goto yy526;
-          if (yych <= 's')
-            goto yy510;
-          goto yy527;
-        }
-      }
-    } else {
-      if (yych <= 0xEC) {
-        if (yych <= 0xC1) {
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        } else {
-          if (yych <= 0xDF)
-            goto yy514;
-          if (yych <= 0xE0)
-            goto yy515;
-          goto yy516;
-        }
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xED)
-            goto yy517;
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy524:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'D') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 'd') {
-          if (yych <= 'E')
-            goto yy528;
-          goto yy510;
-        } else {
-          if (yych <= 'e')
-            goto yy528;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy525:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'D') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 'd') {
-          if (yych <= 'E')
-            goto yy529;
-          goto yy510;
-        } else {
-          if (yych <= 'e')
-            goto yy529;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy526:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'Q') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 'q') {
-          if (yych <= 'R')
-            goto yy530;
-          goto yy510;
-        } else {
-          if (yych <= 'r')
-            goto yy530;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy527:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'X') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 'x') {
-          if (yych <= 'Y')
-            goto yy531;
-          goto yy510;
-        } else {
-          if (yych <= 'y')
-            goto yy531;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy528:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'W') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 'w') {
-          if (yych <= 'X')
-            goto yy532;
-          goto yy510;
-        } else {
-          if (yych <= 'x')
-            goto yy532;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy529:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xDF) {
-      if (yych <= '=') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= '>')
-          goto yy533;
-        if (yych <= 0x7F)
-          goto yy510;
-        if (yych <= 0xC1)
-          goto yy512;
-        goto yy514;
-      }
-    } else {
-      if (yych <= 0xEF) {
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych == 0xED)
-          goto yy517;
-        goto yy516;
-      } else {
-        if (yych <= 0xF0)
-          goto yy518;
-        if (yych <= 0xF3)
-          goto yy519;
-        if (yych <= 0xF4)
-          goto yy520;
-        goto yy512;
-      }
-    }
-  yy530:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'H') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 'h') {
-          if (yych <= 'I')
-            goto yy535;
-          goto yy510;
-        } else {
-          if (yych <= 'i')
-            goto yy535;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy531:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'K') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 'k') {
-          if (yych <= 'L')
-            goto yy525;
-          goto yy510;
-        } else {
-          if (yych <= 'l')
-            goto yy525;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy532:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'S') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 's') {
-          if (yych <= 'T')
-            goto yy536;
-          goto yy510;
-        } else {
-          if (yych <= 't')
-            goto yy536;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy533:
-    yyaccept = 1;
-    yych = *(marker = ++p);
-    if (yybm[0 + yych] & 64) {
-      goto yy510;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\n')
-          goto yy534;
-        if (yych <= '<')
-          goto yy513;
-      } else {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        goto yy516;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy517;
-        if (yych <= 0xEF)
-          goto yy516;
-        goto yy518;
-      } else {
-        if (yych <= 0xF3)
-          goto yy519;
-        if (yych <= 0xF4)
-          goto yy520;
-      }
-    }
-  yy534 : { return (bufsize_t)(p - start); }
-  yy535:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'O') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 'o') {
-          if (yych <= 'P')
-            goto yy537;
-          goto yy510;
-        } else {
-          if (yych <= 'p')
-            goto yy537;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy536:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= '@') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= '`') {
-          if (yych <= 'A')
-            goto yy538;
-          goto yy510;
-        } else {
-          if (yych <= 'a')
-            goto yy538;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy537:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'S') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 's') {
-          if (yych <= 'T')
-            goto yy529;
-          goto yy510;
-        } else {
-          if (yych <= 't')
-            goto yy529;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy538:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'Q') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 'q') {
-          if (yych >= 'S')
-            goto yy510;
-        } else {
-          if (yych <= 'r')
-            goto yy539;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy539:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= 'D') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= 'd') {
-          if (yych >= 'F')
-            goto yy510;
-        } else {
-          if (yych <= 'e')
-            goto yy540;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  yy540:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy513;
-    }
-    if (yych <= 0xC1) {
-      if (yych <= '@') {
-        if (yych <= 0x00)
-          goto yy512;
-        if (yych == '\n')
-          goto yy512;
-        goto yy510;
-      } else {
-        if (yych <= '`') {
-          if (yych <= 'A')
-            goto yy529;
-          goto yy510;
-        } else {
-          if (yych <= 'a')
-            goto yy529;
-          if (yych <= 0x7F)
-            goto yy510;
-          goto yy512;
-        }
-      }
-    } else {
-      if (yych <= 0xED) {
-        if (yych <= 0xDF)
-          goto yy514;
-        if (yych <= 0xE0)
-          goto yy515;
-        if (yych <= 0xEC)
-          goto yy516;
-        goto yy517;
-      } else {
-        if (yych <= 0xF0) {
-          if (yych <= 0xEF)
-            goto yy516;
-          goto yy518;
-        } else {
-          if (yych <= 0xF3)
-            goto yy519;
-          if (yych <= 0xF4)
-            goto yy520;
-          goto yy512;
-        }
-      }
-    }
-  }
-}
-
-// Try to match an HTML block end line of type 2
-bufsize_t _scan_html_block_end_2(const unsigned char *p) {
-  const unsigned char *marker = NULL;
-  const unsigned char *start = p;
-
-  {
-    unsigned char yych;
-    unsigned int yyaccept = 0;
-    static const unsigned char yybm[] = {
-        0,  64, 64, 64, 64, 64, 64, 64, 64, 64,  0,  64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64, 64, 64, 128, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,
-    };
-    yych = *p;
-    if (yych <= 0xDF) {
-      if (yych <= ',') {
-        if (yych <= 0x00)
-          goto yy542;
-        if (yych != '\n')
-          goto yy544;
-      } else {
-        if (yych <= '-')
-          goto yy545;
-        if (yych <= 0x7F)
-          goto yy544;
-        if (yych >= 0xC2)
-          goto yy546;
-      }
-    } else {
-      if (yych <= 0xEF) {
-        if (yych <= 0xE0)
-          goto yy547;
-        if (yych == 0xED)
-          goto yy549;
-        goto yy548;
-      } else {
-        if (yych <= 0xF0)
-          goto yy550;
-        if (yych <= 0xF3)
-          goto yy551;
-        if (yych <= 0xF4)
-          goto yy552;
-      }
-    }
-  yy542:
-    ++p;
-  yy543 : { return 0; }
-  yy544:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= '\n') {
-      if (yych <= 0x00)
-        goto yy543;
-      if (yych <= '\t')
-        goto yy554;
-      goto yy543;
-    } else {
-      if (yych <= 0x7F)
-        goto yy554;
-      if (yych <= 0xC1)
-        goto yy543;
-      if (yych <= 0xF4)
-        goto yy554;
-      goto yy543;
-    }
-  yy545:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yybm[0 + yych] & 128) {
-      goto yy564;
-    }
-    if (yych <= '\n') {
-      if (yych <= 0x00)
-        goto yy543;
-      if (yych <= '\t')
-        goto yy554;
-      goto yy543;
-    } else {
-      if (yych <= 0x7F)
-        goto yy554;
-      if (yych <= 0xC1)
-        goto yy543;
-      if (yych <= 0xF4)
-        goto yy554;
-      goto yy543;
-    }
-  yy546:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy543;
-    if (yych <= 0xBF)
-      goto yy553;
-    goto yy543;
-  yy547:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x9F)
-      goto yy543;
-    if (yych <= 0xBF)
-      goto yy557;
-    goto yy543;
-  yy548:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy543;
-    if (yych <= 0xBF)
-      goto yy557;
-    goto yy543;
-  yy549:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy543;
-    if (yych <= 0x9F)
-      goto yy557;
-    goto yy543;
-  yy550:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x8F)
-      goto yy543;
-    if (yych <= 0xBF)
-      goto yy559;
-    goto yy543;
-  yy551:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy543;
-    if (yych <= 0xBF)
-      goto yy559;
-    goto yy543;
-  yy552:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy543;
-    if (yych <= 0x8F)
-      goto yy559;
-    goto yy543;
-  yy553:
-    yych = *++p;
-  yy554:
-    if (yybm[0 + yych] & 64) {
-      goto yy553;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\n')
-          goto yy555;
-        if (yych <= '-')
-          goto yy556;
-      } else {
-        if (yych <= 0xDF)
-          goto yy557;
-        if (yych <= 0xE0)
-          goto yy558;
-        goto yy559;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy560;
-        if (yych <= 0xEF)
-          goto yy559;
-        goto yy561;
-      } else {
-        if (yych <= 0xF3)
-          goto yy562;
-        if (yych <= 0xF4)
-          goto yy563;
-      }
-    }
-  yy555:
-    p = marker;
-    if (yyaccept == 0) {
-      goto yy543;
-    } else {
-      goto yy566;
-    }
-  yy556:
-    yych = *++p;
-    if (yybm[0 + yych] & 64) {
-      goto yy553;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\n')
-          goto yy555;
-        if (yych <= '-')
-          goto yy564;
-        goto yy555;
-      } else {
-        if (yych <= 0xDF)
-          goto yy557;
-        if (yych <= 0xE0)
-          goto yy558;
-        goto yy559;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy560;
-        if (yych <= 0xEF)
-          goto yy559;
-        goto yy561;
-      } else {
-        if (yych <= 0xF3)
-          goto yy562;
-        if (yych <= 0xF4)
-          goto yy563;
-        goto yy555;
-      }
-    }
-  yy557:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy555;
-    if (yych <= 0xBF)
-      goto yy553;
-    goto yy555;
-  yy558:
-    yych = *++p;
-    if (yych <= 0x9F)
-      goto yy555;
-    if (yych <= 0xBF)
-      goto yy557;
-    goto yy555;
-  yy559:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy555;
-    if (yych <= 0xBF)
-      goto yy557;
-    goto yy555;
-  yy560:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy555;
-    if (yych <= 0x9F)
-      goto yy557;
-    goto yy555;
-  yy561:
-    yych = *++p;
-    if (yych <= 0x8F)
-      goto yy555;
-    if (yych <= 0xBF)
-      goto yy559;
-    goto yy555;
-  yy562:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy555;
-    if (yych <= 0xBF)
-      goto yy559;
-    goto yy555;
-  yy563:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy555;
-    if (yych <= 0x8F)
-      goto yy559;
-    goto yy555;
-  yy564:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy564;
-    }
-    if (yych <= 0xDF) {
-      if (yych <= '=') {
-        if (yych <= 0x00)
-          goto yy555;
-        if (yych == '\n')
-          goto yy555;
-        goto yy553;
-      } else {
-        if (yych <= '>')
-          goto yy565;
-        if (yych <= 0x7F)
-          goto yy553;
-        if (yych <= 0xC1)
-          goto yy555;
-        goto yy557;
-      }
-    } else {
-      if (yych <= 0xEF) {
-        if (yych <= 0xE0)
-          goto yy558;
-        if (yych == 0xED)
-          goto yy560;
-        goto yy559;
-      } else {
-        if (yych <= 0xF0)
-          goto yy561;
-        if (yych <= 0xF3)
-          goto yy562;
-        if (yych <= 0xF4)
-          goto yy563;
-        goto yy555;
-      }
-    }
-  yy565:
-    yyaccept = 1;
-    yych = *(marker = ++p);
-    if (yybm[0 + yych] & 64) {
-      goto yy553;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\n')
-          goto yy566;
-        if (yych <= '-')
-          goto yy556;
-      } else {
-        if (yych <= 0xDF)
-          goto yy557;
-        if (yych <= 0xE0)
-          goto yy558;
-        goto yy559;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy560;
-        if (yych <= 0xEF)
-          goto yy559;
-        goto yy561;
-      } else {
-        if (yych <= 0xF3)
-          goto yy562;
-        if (yych <= 0xF4)
-          goto yy563;
-      }
-    }
-  yy566 : { return (bufsize_t)(p - start); }
-  }
-}
-
-// Try to match an HTML block end line of type 3
-bufsize_t _scan_html_block_end_3(const unsigned char *p) {
-  const unsigned char *marker = NULL;
-  const unsigned char *start = p;
-
-  {
-    unsigned char yych;
-    unsigned int yyaccept = 0;
-    static const unsigned char yybm[] = {
-        0,  64, 64, 64, 64, 64, 64, 64, 64, 64,  0,  64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64, 64, 64, 128, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64, 64, 64, 64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,  0,  0,  0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,
-    };
-    yych = *p;
-    if (yych <= 0xDF) {
-      if (yych <= '>') {
-        if (yych <= 0x00)
-          goto yy568;
-        if (yych != '\n')
-          goto yy570;
-      } else {
-        if (yych <= '?')
-          goto yy571;
-        if (yych <= 0x7F)
-          goto yy570;
-        if (yych >= 0xC2)
-          goto yy572;
-      }
-    } else {
-      if (yych <= 0xEF) {
-        if (yych <= 0xE0)
-          goto yy573;
-        if (yych == 0xED)
-          goto yy575;
-        goto yy574;
-      } else {
-        if (yych <= 0xF0)
-          goto yy576;
-        if (yych <= 0xF3)
-          goto yy577;
-        if (yych <= 0xF4)
-          goto yy578;
-      }
-    }
-  yy568:
-    ++p;
-  yy569 : { return 0; }
-  yy570:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= '\n') {
-      if (yych <= 0x00)
-        goto yy569;
-      if (yych <= '\t')
-        goto yy580;
-      goto yy569;
-    } else {
-      if (yych <= 0x7F)
-        goto yy580;
-      if (yych <= 0xC1)
-        goto yy569;
-      if (yych <= 0xF4)
-        goto yy580;
-      goto yy569;
-    }
-  yy571:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= '=') {
-      if (yych <= 0x00)
-        goto yy569;
-      if (yych == '\n')
-        goto yy569;
-      goto yy580;
-    } else {
-      if (yych <= 0x7F) {
-        if (yych <= '>')
-          goto yy590;
-        goto yy580;
-      } else {
-        if (yych <= 0xC1)
-          goto yy569;
-        if (yych <= 0xF4)
-          goto yy580;
-        goto yy569;
-      }
-    }
-  yy572:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy569;
-    if (yych <= 0xBF)
-      goto yy579;
-    goto yy569;
-  yy573:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x9F)
-      goto yy569;
-    if (yych <= 0xBF)
-      goto yy583;
-    goto yy569;
-  yy574:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy569;
-    if (yych <= 0xBF)
-      goto yy583;
-    goto yy569;
-  yy575:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy569;
-    if (yych <= 0x9F)
-      goto yy583;
-    goto yy569;
-  yy576:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x8F)
-      goto yy569;
-    if (yych <= 0xBF)
-      goto yy585;
-    goto yy569;
-  yy577:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy569;
-    if (yych <= 0xBF)
-      goto yy585;
-    goto yy569;
-  yy578:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy569;
-    if (yych <= 0x8F)
-      goto yy585;
-    goto yy569;
-  yy579:
-    yych = *++p;
-  yy580:
-    if (yybm[0 + yych] & 64) {
-      goto yy579;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\n')
-          goto yy581;
-        if (yych <= '?')
-          goto yy582;
-      } else {
-        if (yych <= 0xDF)
-          goto yy583;
-        if (yych <= 0xE0)
-          goto yy584;
-        goto yy585;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy586;
-        if (yych <= 0xEF)
-          goto yy585;
-        goto yy587;
-      } else {
-        if (yych <= 0xF3)
-          goto yy588;
-        if (yych <= 0xF4)
-          goto yy589;
-      }
-    }
-  yy581:
-    p = marker;
-    if (yyaccept == 0) {
-      goto yy569;
-    } else {
-      goto yy591;
-    }
-  yy582:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy582;
-    }
-    if (yych <= 0xDF) {
-      if (yych <= '=') {
-        if (yych <= 0x00)
-          goto yy581;
-        if (yych == '\n')
-          goto yy581;
-        goto yy579;
-      } else {
-        if (yych <= '>')
-          goto yy590;
-        if (yych <= 0x7F)
-          goto yy579;
-        if (yych <= 0xC1)
-          goto yy581;
-      }
-    } else {
-      if (yych <= 0xEF) {
-        if (yych <= 0xE0)
-          goto yy584;
-        if (yych == 0xED)
-          goto yy586;
-        goto yy585;
-      } else {
-        if (yych <= 0xF0)
-          goto yy587;
-        if (yych <= 0xF3)
-          goto yy588;
-        if (yych <= 0xF4)
-          goto yy589;
-        goto yy581;
-      }
-    }
-  yy583:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy581;
-    if (yych <= 0xBF)
-      goto yy579;
-    goto yy581;
-  yy584:
-    yych = *++p;
-    if (yych <= 0x9F)
-      goto yy581;
-    if (yych <= 0xBF)
-      goto yy583;
-    goto yy581;
-  yy585:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy581;
-    if (yych <= 0xBF)
-      goto yy583;
-    goto yy581;
-  yy586:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy581;
-    if (yych <= 0x9F)
-      goto yy583;
-    goto yy581;
-  yy587:
-    yych = *++p;
-    if (yych <= 0x8F)
-      goto yy581;
-    if (yych <= 0xBF)
-      goto yy585;
-    goto yy581;
-  yy588:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy581;
-    if (yych <= 0xBF)
-      goto yy585;
-    goto yy581;
-  yy589:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy581;
-    if (yych <= 0x8F)
-      goto yy585;
-    goto yy581;
-  yy590:
-    yyaccept = 1;
-    yych = *(marker = ++p);
-    if (yybm[0 + yych] & 64) {
-      goto yy579;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\n')
-          goto yy591;
-        if (yych <= '?')
-          goto yy582;
-      } else {
-        if (yych <= 0xDF)
-          goto yy583;
-        if (yych <= 0xE0)
-          goto yy584;
-        goto yy585;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy586;
-        if (yych <= 0xEF)
-          goto yy585;
-        goto yy587;
-      } else {
-        if (yych <= 0xF3)
-          goto yy588;
-        if (yych <= 0xF4)
-          goto yy589;
-      }
-    }
-  yy591 : { return (bufsize_t)(p - start); }
-  }
-}
-
-// Try to match an HTML block end line of type 4
-bufsize_t _scan_html_block_end_4(const unsigned char *p) {
-  const unsigned char *marker = NULL;
-  const unsigned char *start = p;
-
-  {
-    unsigned char yych;
-    unsigned int yyaccept = 0;
-    static const unsigned char yybm[] = {
-        0,   128, 128, 128, 128, 128, 128, 128, 128, 128, 0,   128, 128, 128,
-        128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-        128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-        128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-        128, 128, 128, 128, 128, 128, 64,  128, 128, 128, 128, 128, 128, 128,
-        128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-        128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-        128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-        128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-        128, 128, 0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-        0,   0,   0,   0,
-    };
-    yych = *p;
-    if (yybm[0 + yych] & 64) {
-      goto yy596;
-    }
-    if (yych <= 0xE0) {
-      if (yych <= '\n') {
-        if (yych <= 0x00)
-          goto yy593;
-        if (yych <= '\t')
-          goto yy595;
-      } else {
-        if (yych <= 0x7F)
-          goto yy595;
-        if (yych <= 0xC1)
-          goto yy593;
-        if (yych <= 0xDF)
-          goto yy598;
-        goto yy599;
-      }
-    } else {
-      if (yych <= 0xEF) {
-        if (yych == 0xED)
-          goto yy601;
-        goto yy600;
-      } else {
-        if (yych <= 0xF0)
-          goto yy602;
-        if (yych <= 0xF3)
-          goto yy603;
-        if (yych <= 0xF4)
-          goto yy604;
-      }
-    }
-  yy593:
-    ++p;
-  yy594 : { return 0; }
-  yy595:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= '\n') {
-      if (yych <= 0x00)
-        goto yy594;
-      if (yych <= '\t')
-        goto yy606;
-      goto yy594;
-    } else {
-      if (yych <= 0x7F)
-        goto yy606;
-      if (yych <= 0xC1)
-        goto yy594;
-      if (yych <= 0xF4)
-        goto yy606;
-      goto yy594;
-    }
-  yy596:
-    yyaccept = 1;
-    yych = *(marker = ++p);
-    if (yybm[0 + yych] & 128) {
-      goto yy605;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\n')
-          goto yy597;
-        if (yych <= '>')
-          goto yy596;
-      } else {
-        if (yych <= 0xDF)
-          goto yy608;
-        if (yych <= 0xE0)
-          goto yy609;
-        goto yy610;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy611;
-        if (yych <= 0xEF)
-          goto yy610;
-        goto yy612;
-      } else {
-        if (yych <= 0xF3)
-          goto yy613;
-        if (yych <= 0xF4)
-          goto yy614;
-      }
-    }
-  yy597 : { return (bufsize_t)(p - start); }
-  yy598:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy594;
-    if (yych <= 0xBF)
-      goto yy605;
-    goto yy594;
-  yy599:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x9F)
-      goto yy594;
-    if (yych <= 0xBF)
-      goto yy608;
-    goto yy594;
-  yy600:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy594;
-    if (yych <= 0xBF)
-      goto yy608;
-    goto yy594;
-  yy601:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy594;
-    if (yych <= 0x9F)
-      goto yy608;
-    goto yy594;
-  yy602:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x8F)
-      goto yy594;
-    if (yych <= 0xBF)
-      goto yy610;
-    goto yy594;
-  yy603:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy594;
-    if (yych <= 0xBF)
-      goto yy610;
-    goto yy594;
-  yy604:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy594;
-    if (yych <= 0x8F)
-      goto yy610;
-    goto yy594;
-  yy605:
-    yych = *++p;
-  yy606:
-    if (yybm[0 + yych] & 128) {
-      goto yy605;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\n')
-          goto yy607;
-        if (yych <= '>')
-          goto yy596;
-      } else {
-        if (yych <= 0xDF)
-          goto yy608;
-        if (yych <= 0xE0)
-          goto yy609;
-        goto yy610;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy611;
-        if (yych <= 0xEF)
-          goto yy610;
-        goto yy612;
-      } else {
-        if (yych <= 0xF3)
-          goto yy613;
-        if (yych <= 0xF4)
-          goto yy614;
-      }
-    }
-  yy607:
-    p = marker;
-    if (yyaccept == 0) {
-      goto yy594;
-    } else {
-      goto yy597;
-    }
-  yy608:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy607;
-    if (yych <= 0xBF)
-      goto yy605;
-    goto yy607;
-  yy609:
-    yych = *++p;
-    if (yych <= 0x9F)
-      goto yy607;
-    if (yych <= 0xBF)
-      goto yy608;
-    goto yy607;
-  yy610:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy607;
-    if (yych <= 0xBF)
-      goto yy608;
-    goto yy607;
-  yy611:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy607;
-    if (yych <= 0x9F)
-      goto yy608;
-    goto yy607;
-  yy612:
-    yych = *++p;
-    if (yych <= 0x8F)
-      goto yy607;
-    if (yych <= 0xBF)
-      goto yy610;
-    goto yy607;
-  yy613:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy607;
-    if (yych <= 0xBF)
-      goto yy610;
-    goto yy607;
-  yy614:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy607;
-    if (yych <= 0x8F)
-      goto yy610;
-    goto yy607;
-  }
-}
-
-// Try to match an HTML block end line of type 5
-bufsize_t _scan_html_block_end_5(const unsigned char *p) {
-  const unsigned char *marker = NULL;
-  const unsigned char *start = p;
-
-  {
-    unsigned char yych;
-    unsigned int yyaccept = 0;
-    static const unsigned char yybm[] = {
-        0,  64, 64, 64,  64, 64, 64, 64, 64, 64, 0,  64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 128, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 64, 64,  64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64, 64,
-        64, 64, 0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,   0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
-        0,  0,  0,  0,
-    };
-    yych = *p;
-    if (yych <= 0xDF) {
-      if (yych <= '\\') {
-        if (yych <= 0x00)
-          goto yy616;
-        if (yych != '\n')
-          goto yy618;
-      } else {
-        if (yych <= ']')
-          goto yy619;
-        if (yych <= 0x7F)
-          goto yy618;
-        if (yych >= 0xC2)
-          goto yy620;
-      }
-    } else {
-      if (yych <= 0xEF) {
-        if (yych <= 0xE0)
-          goto yy621;
-        if (yych == 0xED)
-          goto yy623;
-        goto yy622;
-      } else {
-        if (yych <= 0xF0)
-          goto yy624;
-        if (yych <= 0xF3)
-          goto yy625;
-        if (yych <= 0xF4)
-          goto yy626;
-      }
-    }
-  yy616:
-    ++p;
-  yy617 : { return 0; }
-  yy618:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= '\n') {
-      if (yych <= 0x00)
-        goto yy617;
-      if (yych <= '\t')
-        goto yy628;
-      goto yy617;
-    } else {
-      if (yych <= 0x7F)
-        goto yy628;
-      if (yych <= 0xC1)
-        goto yy617;
-      if (yych <= 0xF4)
-        goto yy628;
-      goto yy617;
-    }
-  yy619:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yybm[0 + yych] & 128) {
-      goto yy638;
-    }
-    if (yych <= '\n') {
-      if (yych <= 0x00)
-        goto yy617;
-      if (yych <= '\t')
-        goto yy628;
-      goto yy617;
-    } else {
-      if (yych <= 0x7F)
-        goto yy628;
-      if (yych <= 0xC1)
-        goto yy617;
-      if (yych <= 0xF4)
-        goto yy628;
-      goto yy617;
-    }
-  yy620:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy617;
-    if (yych <= 0xBF)
-      goto yy627;
-    goto yy617;
-  yy621:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x9F)
-      goto yy617;
-    if (yych <= 0xBF)
-      goto yy631;
-    goto yy617;
-  yy622:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy617;
-    if (yych <= 0xBF)
-      goto yy631;
-    goto yy617;
-  yy623:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy617;
-    if (yych <= 0x9F)
-      goto yy631;
-    goto yy617;
-  yy624:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x8F)
-      goto yy617;
-    if (yych <= 0xBF)
-      goto yy633;
-    goto yy617;
-  yy625:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy617;
-    if (yych <= 0xBF)
-      goto yy633;
-    goto yy617;
-  yy626:
-    yyaccept = 0;
-    yych = *(marker = ++p);
-    if (yych <= 0x7F)
-      goto yy617;
-    if (yych <= 0x8F)
-      goto yy633;
-    goto yy617;
-  yy627:
-    yych = *++p;
-  yy628:
-    if (yybm[0 + yych] & 64) {
-      goto yy627;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\n')
-          goto yy629;
-        if (yych <= ']')
-          goto yy630;
-      } else {
-        if (yych <= 0xDF)
-          goto yy631;
-        if (yych <= 0xE0)
-          goto yy632;
-        goto yy633;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy634;
-        if (yych <= 0xEF)
-          goto yy633;
-        goto yy635;
-      } else {
-        if (yych <= 0xF3)
-          goto yy636;
-        if (yych <= 0xF4)
-          goto yy637;
-      }
-    }
-  yy629:
-    p = marker;
-    if (yyaccept == 0) {
-      goto yy617;
-    } else {
-      goto yy640;
-    }
-  yy630:
-    yych = *++p;
-    if (yybm[0 + yych] & 64) {
-      goto yy627;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\n')
-          goto yy629;
-        if (yych <= ']')
-          goto yy638;
-        goto yy629;
-      } else {
-        if (yych <= 0xDF)
-          goto yy631;
-        if (yych <= 0xE0)
-          goto yy632;
-        goto yy633;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy634;
-        if (yych <= 0xEF)
-          goto yy633;
-        goto yy635;
-      } else {
-        if (yych <= 0xF3)
-          goto yy636;
-        if (yych <= 0xF4)
-          goto yy637;
-        goto yy629;
-      }
-    }
-  yy631:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy629;
-    if (yych <= 0xBF)
-      goto yy627;
-    goto yy629;
-  yy632:
-    yych = *++p;
-    if (yych <= 0x9F)
-      goto yy629;
-    if (yych <= 0xBF)
-      goto yy631;
-    goto yy629;
-  yy633:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy629;
-    if (yych <= 0xBF)
-      goto yy631;
-    goto yy629;
-  yy634:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy629;
-    if (yych <= 0x9F)
-      goto yy631;
-    goto yy629;
-  yy635:
-    yych = *++p;
-    if (yych <= 0x8F)
-      goto yy629;
-    if (yych <= 0xBF)
-      goto yy633;
-    goto yy629;
-  yy636:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy629;
-    if (yych <= 0xBF)
-      goto yy633;
-    goto yy629;
-  yy637:
-    yych = *++p;
-    if (yych <= 0x7F)
-      goto yy629;
-    if (yych <= 0x8F)
-      goto yy633;
-    goto yy629;
-  yy638:
-    yych = *++p;
-    if (yybm[0 + yych] & 128) {
-      goto yy638;
-    }
-    if (yych <= 0xDF) {
-      if (yych <= '=') {
-        if (yych <= 0x00)
-          goto yy629;
-        if (yych == '\n')
-          goto yy629;
-        goto yy627;
-      } else {
-        if (yych <= '>')
-          goto yy639;
-        if (yych <= 0x7F)
-          goto yy627;
-        if (yych <= 0xC1)
-          goto yy629;
-        goto yy631;
-      }
-    } else {
-      if (yych <= 0xEF) {
-        if (yych <= 0xE0)
-          goto yy632;
-        if (yych == 0xED)
-          goto yy634;
-        goto yy633;
-      } else {
-        if (yych <= 0xF0)
-          goto yy635;
-        if (yych <= 0xF3)
-          goto yy636;
-        if (yych <= 0xF4)
-          goto yy637;
-        goto yy629;
-      }
-    }
-  yy639:
-    yyaccept = 1;
-    yych = *(marker = ++p);
-    if (yybm[0 + yych] & 64) {
-      goto yy627;
-    }
-    if (yych <= 0xEC) {
-      if (yych <= 0xC1) {
-        if (yych <= '\n')
-          goto yy640;
-        if (yych <= ']')
-          goto yy630;
-      } else {
-        if (yych <= 0xDF)
-          goto yy631;
-        if (yych <= 0xE0)
-          goto yy632;
-        goto yy633;
-      }
-    } else {
-      if (yych <= 0xF0) {
-        if (yych <= 0xED)
-          goto yy634;
-        if (yych <= 0xEF)
-          goto yy633;
-        goto yy635;
-      } else {
-        if (yych <= 0xF3)
-          goto yy636;
-        if (yych <= 0xF4)
-          goto yy637;
-      }
-    }
-  yy640 : { return (bufsize_t)(p - start); }
-  }
-}
-
 // Try to match a link title (in single quotes, in double quotes, or
 // in parentheses), returning number of chars matched.  Allow one
 // level of internal nesting (quotes within quotes).
@@ -0,0 +1,108 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "scratch.h"
+
+#define SCRATCH_ALIGN 16
+#define SCRATCH_MIN_CHUNK_SIZE 8192
+/* Chunks larger than this are given back once released, so that a single
+ * huge line doesn't pin its scratch space for the life of the parser */
+#define SCRATCH_MAX_KEPT_SIZE (1 << 20)
+
+struct cmark_scratch_chunk {
+  struct cmark_scratch_chunk *prev;
+  size_t size, used;
+};
+
+/* Chunk headers are padded so that the data following them is aligned */
+#define CHUNK_HEADER_SIZE                                                      \
+  ((sizeof(struct cmark_scratch_chunk) + SCRATCH_ALIGN - 1) &                  \
+   ~(size_t)(SCRATCH_ALIGN - 1))
+
+static unsigned char *chunk_data(struct cmark_scratch_chunk *chunk) {
+  return (unsigned char *)chunk + CHUNK_HEADER_SIZE;
+}
+
+void *cmark_scratch_alloc(cmark_scratch *scratch, size_t size) {
+  struct cmark_scratch_chunk *chunk = scratch->chunk;
+  unsigned char *ptr;
+
+  size = (size + SCRATCH_ALIGN - 1) & ~(size_t)(SCRATCH_ALIGN - 1);
+
+  if (!chunk || chunk->size - chunk->used < size) {
+    cmark_mem *mem = cmark_get_default_mem_allocator();
+    size_t chunk_size = chunk ? chunk->size * 2 : SCRATCH_MIN_CHUNK_SIZE;
+
+    if (chunk_size < size)
+      chunk_size = size;
+    chunk = (struct cmark_scratch_chunk *)mem->calloc(
+        1, CHUNK_HEADER_SIZE + chunk_size);
+    chunk->prev = scratch->chunk;
+    chunk->size = chunk_size;
+    scratch->chunk = chunk;
+  }
+
+  ptr = chunk_data(chunk) + chunk->used;
+  chunk->used += size;
+  memset(ptr, 0, size);
+  return ptr;
+}
+
+cmark_scratch_mark cmark_scratch_get_mark(cmark_scratch *scratch) {
+  cmark_scratch_mark mark;
+
+  // An empty region is always marked with a null chunk, even when a chunk
+  // is being kept for reuse, as releasing to such a mark may swap it out.
+  if (!scratch->chunk ||
+      (!scratch->chunk->used && !scratch->chunk->prev)) {
+    mark.chunk = NULL;
+    mark.used = 0;
+  } else {
+    mark.chunk = scratch->chunk;
+    mark.used = scratch->chunk->used;
+  }
+  return mark;
+}
+
+void cmark_scratch_release(cmark_scratch *scratch, cmark_scratch_mark mark) {
+  cmark_mem *mem = cmark_get_default_mem_allocator();
+  struct cmark_scratch_chunk *chunk = scratch->chunk;
+
+  if (!mark.chunk) {
+    // Released down to nothing: keep the newest chunk, which is also the
+    // largest, so that the next line of the same size needs no allocation.
+    if (!chunk)
+      return;
+    while (chunk->prev) {
+      struct cmark_scratch_chunk *prev = chunk->prev;
+      chunk->prev = prev->prev;
+      mem->free(prev);
+    }
+    if (chunk->size > SCRATCH_MAX_KEPT_SIZE) {
+      mem->free(chunk);
+      chunk = NULL;
+    } else {
+      chunk->used = 0;
+    }
+    scratch->chunk = chunk;
+    return;
+  }
+
+  while (chunk != mark.chunk) {
+    struct cmark_scratch_chunk *prev = chunk->prev;
+    mem->free(chunk);
+    chunk = prev;
+  }
+  chunk->used = mark.used;
+  scratch->chunk = chunk;
+}
+
+void cmark_scratch_free(cmark_scratch *scratch) {
+  cmark_mem *mem = cmark_get_default_mem_allocator();
+
+  while (scratch->chunk) {
+    struct cmark_scratch_chunk *prev = scratch->chunk->prev;
+    mem->free(scratch->chunk);
+    scratch->chunk = prev;
+  }
+}
@@ -0,0 +1,39 @@
+#ifndef CMARK_SCRATCH_H
+#define CMARK_SCRATCH_H
+
+#include <stddef.h>
+#include "cmark-gfm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct cmark_scratch_chunk;
+
+/* Stack-like region for allocations that don't outlive the parsing of a
+ * line or block.  Memory is handed out by bumping a pointer and is only
+ * given back by rewinding to a mark taken earlier, so nested users (a
+ * line fed reentrantly from an extension callback, say) release exactly
+ * what they allocated.  Chunks come from the default allocator rather
+ * than the document's, and the largest one is kept for reuse. */
+typedef struct cmark_scratch {
+  struct cmark_scratch_chunk *chunk;
+} cmark_scratch;
+
+typedef struct cmark_scratch_mark {
+  struct cmark_scratch_chunk *chunk;
+  size_t used;
+} cmark_scratch_mark;
+
+/* Returns 'size' zeroed bytes, aligned for any scalar type */
+void *cmark_scratch_alloc(cmark_scratch *scratch, size_t size);
+cmark_scratch_mark cmark_scratch_get_mark(cmark_scratch *scratch);
+/* Releases everything allocated since 'mark' was taken */
+void cmark_scratch_release(cmark_scratch *scratch, cmark_scratch_mark mark);
+void cmark_scratch_free(cmark_scratch *scratch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -4,17 +4,25 @@
 #include "cmark-gfm.h"
 #include "syntax_extension.h"
 #include "buffer.h"
+#include "cmark_ctype.h"
 
 extern cmark_mem CMARK_DEFAULT_MEM_ALLOCATOR;
 
 static cmark_mem *_mem = &CMARK_DEFAULT_MEM_ALLOCATOR;
 
+static void S_free_string(cmark_mem *mem, void *data) {
+  mem->free(data);
+}
+
 void cmark_syntax_extension_free(cmark_mem *mem, cmark_syntax_extension *extension) {
   if (extension->free_function && extension->priv) {
     extension->free_function(mem, extension->priv);
   }
 
   cmark_llist_free(mem, extension->special_inline_chars);
+  cmark_llist_free(mem, extension->block_trigger_chars);
+  cmark_llist_free_full(mem, extension->html_filter_tags, S_free_string);
+  mem->free(extension->postprocess_node_types);
   mem->free(extension->name);
   mem->free(extension);
 }
@@ -62,6 +70,11 @@ void cmark_syntax_extension_set_inline_from_delim_func(cmark_syntax_extension *e
   extension->insert_inline_from_delim = func;
 }
 
+void cmark_syntax_extension_set_block_trigger_chars(cmark_syntax_extension *extension,
+                                                    cmark_llist *trigger_chars) {
+  extension->block_trigger_chars = trigger_chars;
+}
+
 void cmark_syntax_extension_set_special_inline_chars(cmark_syntax_extension *extension,
                                                      cmark_llist *special_chars) {
   extension->special_inline_chars = special_chars;
@@ -117,11 +130,64 @@ void cmark_syntax_extension_set_html_filter_func(cmark_syntax_extension *extensi
   extension->html_filter_func = func;
 }
 
+int cmark_syntax_extension_set_html_filter_tags(cmark_syntax_extension *extension,
+                                                const char **tags) {
+  cmark_llist *list = NULL;
+  const char **it;
+  const char *c;
+  char *copy;
+
+  for (it = tags; it && *it; ++it) {
+    if (!**it)
+      return 0;
+    for (c = *it; *c; ++c)
+      if (!cmark_isalnum(*c) && *c != '-')
+        return 0;
+  }
+
+  for (it = tags; it && *it; ++it) {
+    copy = (char *) _mem->calloc(strlen(*it) + 1, 1);
+    strcpy(copy, *it);
+    list = cmark_llist_append(_mem, list, copy);
+  }
+
+  cmark_llist_free_full(_mem, extension->html_filter_tags, S_free_string);
+  extension->html_filter_tags = list;
+  return 1;
+}
+
 void cmark_syntax_extension_set_postprocess_func(cmark_syntax_extension *extension,
                                                  cmark_postprocess_func func) {
   extension->postprocess_func = func;
 }
 
+void cmark_syntax_extension_set_postprocess_node_func(cmark_syntax_extension *extension,
+                                                      cmark_postprocess_node_func func) {
+  extension->postprocess_node_func = func;
+}
+
+void cmark_syntax_extension_set_postprocess_inlines_func(cmark_syntax_extension *extension,
+                                                         cmark_postprocess_inlines_func func) {
+  extension->postprocess_inlines_func = func;
+}
+
+void cmark_syntax_extension_set_postprocess_node_types(cmark_syntax_extension *extension,
+                                                       const cmark_node_type *types) {
+  size_t n = 0;
+
+  _mem->free(extension->postprocess_node_types);
+  extension->postprocess_node_types = NULL;
+
+  if (!types)
+    return;
+
+  while (types[n] != CMARK_NODE_NONE)
+    ++n;
+  extension->postprocess_node_types =
+      (cmark_node_type *) _mem->calloc(n + 1, sizeof(cmark_node_type));
+  memcpy(extension->postprocess_node_types, types, n * sizeof(cmark_node_type));
+}
+
 void cmark_syntax_extension_set_private(cmark_syntax_extension *extension,
                                         void *priv,
                                         cmark_free_func free_func) {
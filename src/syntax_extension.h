@@ -11,6 +11,7 @@ struct cmark_syntax_extension {
   cmark_match_inline_func         match_inline;
   cmark_inline_from_delim_func    insert_inline_from_delim;
   cmark_llist                   * special_inline_chars;
+  cmark_llist                   * block_trigger_chars;
   char                          * name;
   void                          * priv;
   bool                            emphasis;
@@ -25,7 +26,11 @@ struct cmark_syntax_extension {
   cmark_common_render_func        man_render_func;
   cmark_html_render_func          html_render_func;
   cmark_html_filter_func          html_filter_func;
+  cmark_llist                   * html_filter_tags;
   cmark_postprocess_func          postprocess_func;
+  cmark_postprocess_node_func     postprocess_node_func;
+  cmark_node_type               * postprocess_node_types;
+  cmark_postprocess_inlines_func  postprocess_inlines_func;
   cmark_opaque_alloc_func         opaque_alloc_func;
   cmark_opaque_free_func          opaque_free_func;
   cmark_commonmark_escape_func    commonmark_escape_func;
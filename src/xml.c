@@ -6,6 +6,7 @@
 #include "config.h"
 #include "cmark-gfm.h"
 #include "node.h"
+#include "iterator.h"
 #include "buffer.h"
 #include "houdini.h"
 #include "syntax_extension.h"
@@ -20,6 +21,15 @@ static void escape_xml(cmark_strbuf *dest, const unsigned char *source,
   houdini_escape_html0(dest, source, length, 0);
 }
 
+// Copies a literal the parser found nothing to escape in as it is.
+static CMARK_INLINE void escape_xml_literal(cmark_strbuf *dest,
+                                            const cmark_chunk *literal) {
+  if (literal->flags & CMARK_CHUNK_NO_HTML_SPECIAL)
+    cmark_strbuf_put(dest, literal->data, literal->len);
+  else
+    escape_xml(dest, literal->data, literal->len);
+}
+
 struct render_state {
   cmark_strbuf *xml;
   int indent;
@@ -69,7 +79,7 @@ static int S_render_node(cmark_node *node, cmark_event_type ev_type,
     case CMARK_NODE_HTML_BLOCK:
     case CMARK_NODE_HTML_INLINE:
       cmark_strbuf_puts(xml, " xml:space=\"preserve\">");
-      escape_xml(xml, node->as.literal.data, node->as.literal.len);
+      escape_xml_literal(xml, &node->as.literal);
       cmark_strbuf_puts(xml, "</");
       cmark_strbuf_puts(xml, cmark_node_get_type_string(node));
       literal = true;
@@ -166,17 +176,17 @@ char *cmark_render_xml_with_mem(cmark_node *root, int options, cmark_mem *mem) {
   cmark_node *cur;
   struct render_state state = {&xml, 0};
 
-  cmark_iter *iter = cmark_iter_new(root);
+  cmark_iter_storage storage;
+  cmark_iter *iter = cmark_iter_init(&storage, root);
 
   cmark_strbuf_puts(state.xml, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
   cmark_strbuf_puts(state.xml,
                     "<!DOCTYPE document SYSTEM \"CommonMark.dtd\">\n");
-  while ((ev_type = cmark_iter_next(iter)) != CMARK_EVENT_DONE) {
-    cur = cmark_iter_get_node(iter);
+  while ((ev_type = cmark_iter_step(iter)) != CMARK_EVENT_DONE) {
+    cur = iter->cur.node;
     S_render_node(cur, ev_type, &state, options);
   }
   result = (char *)cmark_strbuf_detach(&xml);
 
-  cmark_iter_free(iter);
   return result;
 }
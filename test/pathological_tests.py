@@ -7,6 +7,7 @@ import sys
 import platform
 import itertools
 import multiprocessing
+import time
 from cmark import CMark
 
 def hash_collisions():
@@ -96,6 +97,12 @@ pathological = {
     "tables":
                  ("aaa\rbbb\n-\v\n" * 30000,
                   re.compile("^<p>aaa</p>\n<table>\n<thead>\n<tr>\n<th>bbb</th>\n</tr>\n</thead>\n<tbody>\n(<tr>\n<td>aaa</td>\n</tr>\n<tr>\n<td>bbb</td>\n</tr>\n<tr>\n<td>-\x0b</td>\n</tr>\n){29999}</tbody>\n</table>\n$")),
+    "huge table":
+                 ("a|b\n-|-\n" + "c|d\n" * 30000,
+                  re.compile("^<table>\n<thead>\n<tr>\n<th>a</th>\n<th>b</th>\n</tr>\n</thead>\n<tbody>\n(<tr>\n<td>c</td>\n<td>d</td>\n</tr>\n){30000}</tbody>\n</table>\n$")),
+    "wide table with short rows":
+                 ("|a" * 1000 + "\n" + "|-" * 1000 + "\n" + "a\n" * 3000,
+                  re.compile("^<table>\n<thead>\n<tr>\n(<th>a</th>\n){1000}</tr>\n</thead>\n<tbody>\n(<tr>\n<td>a</td>\n(<td></td>\n){999}</tr>\n){525}</tbody>\n</table>\n<p>a(\na){2474}</p>\n$")),
 #    "many references":
 #                 ("".join(map(lambda x: ("[" + str(x) + "]: u\n"), range(1,5000 * 16))) + "[0] " * 5000,
 #                  re.compile("(\[0\] ){4999}")),
@@ -108,14 +115,43 @@ errored = 0
 ignored = 0
 TIMEOUT = 5
 
-def run_test(inp, regex):
+# Inputs whose rendering time must grow linearly with their size: each is
+# rendered with n and SCALING_FACTOR * n repetitions, and the larger may
+# take at most SCALING_LIMIT times as long as the smaller.
+scaling = {
+    "table rows":
+                 (lambda n: "a|b\n-|-\n" + "c|d\n" * n, 10000),
+    "table columns":
+                 (lambda n: "|a" * n + "\n" + "|-" * n + "\n" + "|b\n" * 10, 2000),
+    "table short rows":
+                 # 50 columns keep even 10n rows under the table
+                 # extension's cap on autocompleted cells.
+                 (lambda n: "|a" * 50 + "\n" + "|-" * 50 + "\n" + "a\n" * n, 1000),
+    }
+SCALING_FACTOR = 10
+SCALING_LIMIT = SCALING_FACTOR * 3
+
+def make_cmark():
     parser = argparse.ArgumentParser(description='Run cmark tests.')
     parser.add_argument('--program', dest='program', nargs='?', default=None,
             help='program to test')
     parser.add_argument('--library-dir', dest='library_dir', nargs='?',
             default=None, help='directory containing dynamic library')
     args = parser.parse_args(sys.argv[1:])
-    cmark = CMark(prog=args.program, library_dir=args.library_dir, extensions="table")
+    return CMark(prog=args.program, library_dir=args.library_dir, extensions="table")
+
+def time_to_html(cmark, inp):
+    best = None
+    for _ in range(3):
+        start = time.perf_counter()
+        cmark.to_html(inp)
+        elapsed = time.perf_counter() - start
+        if best is None or elapsed < best:
+            best = elapsed
+    return best
+
+def run_test(inp, regex):
+    cmark = make_cmark()
 
     [rc, actual, err] = cmark.to_html(inp)
     if rc != 0:
@@ -156,5 +192,23 @@ if __name__ == '__main__':
         else:
             passed += 1
 
+    print("Testing scaling:")
+    cmark = make_cmark()
+    for description in scaling:
+        (make_input, n) = scaling[description]
+        print(description, "... ", end='')
+        sys.stdout.flush()
+
+        small = time_to_html(cmark, make_input(n))
+        large = time_to_html(cmark, make_input(n * SCALING_FACTOR))
+        ratio = large / max(small, 1e-6)
+        if ratio > SCALING_LIMIT:
+            print('[FAILED (%.1fx slower for %dx the input)]' %
+                  (ratio, SCALING_FACTOR))
+            errored += 1
+        else:
+            print('[PASSED (%.1fx)]' % ratio)
+            passed += 1
+
     print("%d passed, %d errored, %d ignored" % (passed, errored, ignored))
     exit(errored)
@@ -1,6 +1,13 @@
-# Creates C data structures for binary lookup table of entities,
+# Creates C data structures for a minimal perfect hash table of entities,
 # using python's html5 entity data.
 # Usage: python3 tools/make_entities_inc.py > src/entities.inc
+#
+# The table uses the "hash and displace" scheme: every name is first
+# hashed into one of CMARK_ENTITY_NUM_BUCKETS buckets, and each bucket
+# stores the seed that makes a second hash send all of its names to
+# distinct, otherwise unused slots of cmark_entities.  A negative value
+# -(slot + 1) marks a bucket holding a single name placed directly.
+# The hash must match S_entity_hash in src/houdini_html_u.c.
 
 import html
 
@@ -11,8 +18,50 @@ entities5 = html.entities.html5
 # without a semicolon.
 entities = sorted([(k[:-1], entities5[k].encode('utf-8')) for k in entities5.keys() if k[-1] == ';'])
 
+FNV_BASIS = 2166136261
+FNV_PRIME = 16777619
+
+def entity_hash(name, seed):
+    h = FNV_BASIS ^ seed
+    for c in name.encode('ascii'):
+        h = ((h ^ c) * FNV_PRIME) & 0xFFFFFFFF
+    return h
+
+num_entities = len(entities)
+num_buckets = (num_entities + 3) // 4
+
+buckets = [[] for _ in range(num_buckets)]
+for i, (ent, _) in enumerate(entities):
+    buckets[entity_hash(ent, 0) % num_buckets].append(i)
+
+displacements = [0] * num_buckets
+slots = [None] * num_entities
+
+# Place the largest buckets first, while most slots are still free.
+order = sorted(range(num_buckets), key=lambda b: -len(buckets[b]))
+for b in order:
+    members = buckets[b]
+    if len(members) <= 1:
+        break
+    seed = 1
+    while True:
+        placed = [entity_hash(entities[i][0], seed) % num_entities for i in members]
+        if len(set(placed)) == len(placed) and all(slots[p] is None for p in placed):
+            break
+        seed += 1
+    for i, p in zip(members, placed):
+        slots[p] = i
+    displacements[b] = seed
+
+free = [p for p in range(num_entities) if slots[p] is None]
+for b in order:
+    if len(buckets[b]) == 1:
+        p = free.pop()
+        slots[p] = buckets[b][0]
+        displacements[b] = -(p + 1)
+
 # Print out the header:
-print("""/* Autogenerated by tools/make_headers_inc.py */
+print("""/* Autogenerated by tools/make_entities_inc.py */
 
 struct cmark_entity_node {
 	unsigned char *entity;
@@ -22,11 +71,18 @@ struct cmark_entity_node {
 #define CMARK_ENTITY_MIN_LENGTH 2
 #define CMARK_ENTITY_MAX_LENGTH 32""")
 
-print("#define CMARK_NUM_ENTITIES " + str(len(entities)));
+print("#define CMARK_NUM_ENTITIES " + str(num_entities))
+print("#define CMARK_ENTITY_NUM_BUCKETS " + str(num_buckets))
+
+print("\nstatic const int32_t cmark_entity_displacements[] = {")
+for i in range(0, num_buckets, 12):
+    print('  ' + ', '.join(map(str, displacements[i:i + 12])) + ',')
+print("};")
 
-print("\nstatic const struct cmark_entity_node cmark_entities[] = {");
+print("\nstatic const struct cmark_entity_node cmark_entities[] = {")
 
-for (ent, bs) in entities:
+for i in slots:
+  ent, bs = entities[i]
   print('{(unsigned char*)"' + ent + '", {' + ', '.join(map(str, bs)) + ', 0}},')
 
 print("};")
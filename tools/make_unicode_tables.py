@@ -0,0 +1,137 @@
+# Creates two-level lookup tables for Unicode case folding and
+# punctuation.
+# Usage: python3 tools/make_unicode_tables.py < data/CaseFolding.txt > src/unicode_tables.inc
+#
+# Both tables split a code point into a high part, which selects a block
+# through a small index array, and a low part, which selects the entry
+# inside that block.  Identical blocks are stored only once, so the large
+# stretches of code points without any mapping share a single block.
+
+import sys
+
+# Code points treated as punctuation by the emphasis rules: the ASCII
+# punctuation characters plus the P[cdefios] general categories, frozen at
+# the Unicode version the parser has always used so that output doesn't
+# depend on the Python version regenerating this file.
+PUNCTUATION_RANGES = [
+    (0x0021, 0x002F), (0x003A, 0x0040), (0x005B, 0x0060), (0x007B, 0x007E),
+    (0x00A1, 0x00A1), (0x00A7, 0x00A7), (0x00AB, 0x00AB), (0x00B6, 0x00B7),
+    (0x00BB, 0x00BB), (0x00BF, 0x00BF), (0x037E, 0x037E), (0x0387, 0x0387),
+    (0x055A, 0x055F), (0x0589, 0x058A), (0x05BE, 0x05BE), (0x05C0, 0x05C0),
+    (0x05C3, 0x05C3), (0x05C6, 0x05C6), (0x05F3, 0x05F4), (0x0609, 0x060A),
+    (0x060C, 0x060D), (0x061B, 0x061B), (0x061E, 0x061F), (0x066A, 0x066D),
+    (0x06D4, 0x06D4), (0x0700, 0x070D), (0x07F7, 0x07F9), (0x0830, 0x083E),
+    (0x085E, 0x085E), (0x0964, 0x0965), (0x0970, 0x0970), (0x0AF0, 0x0AF0),
+    (0x0DF4, 0x0DF4), (0x0E4F, 0x0E4F), (0x0E5A, 0x0E5B), (0x0F04, 0x0F12),
+    (0x0F14, 0x0F14), (0x0F3A, 0x0F3D), (0x0F85, 0x0F85), (0x0FD0, 0x0FD4),
+    (0x0FD9, 0x0FDA), (0x104A, 0x104F), (0x10FB, 0x10FB), (0x1360, 0x1368),
+    (0x1400, 0x1400), (0x166D, 0x166E), (0x169B, 0x169C), (0x16EB, 0x16ED),
+    (0x1735, 0x1736), (0x17D4, 0x17D6), (0x17D8, 0x17DA), (0x1800, 0x180A),
+    (0x1944, 0x1945), (0x1A1E, 0x1A1F), (0x1AA0, 0x1AA6), (0x1AA8, 0x1AAD),
+    (0x1B5A, 0x1B60), (0x1BFC, 0x1BFF), (0x1C3B, 0x1C3F), (0x1C7E, 0x1C7F),
+    (0x1CC0, 0x1CC7), (0x1CD3, 0x1CD3), (0x2010, 0x2027), (0x2030, 0x2043),
+    (0x2045, 0x2051), (0x2053, 0x205E), (0x207D, 0x207E), (0x208D, 0x208E),
+    (0x2308, 0x230B), (0x2329, 0x232A), (0x2768, 0x2775), (0x27C5, 0x27C6),
+    (0x27E6, 0x27EF), (0x2983, 0x2998), (0x29D8, 0x29DB), (0x29FC, 0x29FD),
+    (0x2CF9, 0x2CFC), (0x2CFE, 0x2CFF), (0x2D70, 0x2D70), (0x2E00, 0x2E2E),
+    (0x2E30, 0x2E42), (0x3001, 0x3003), (0x3008, 0x3011), (0x3014, 0x301F),
+    (0x3030, 0x3030), (0x303D, 0x303D), (0x30A0, 0x30A0), (0x30FB, 0x30FB),
+    (0xA4FE, 0xA4FF), (0xA60D, 0xA60F), (0xA673, 0xA673), (0xA67E, 0xA67E),
+    (0xA6F2, 0xA6F7), (0xA874, 0xA877), (0xA8CE, 0xA8CF), (0xA8F8, 0xA8FA),
+    (0xA92E, 0xA92F), (0xA95F, 0xA95F), (0xA9C1, 0xA9CD), (0xA9DE, 0xA9DF),
+    (0xAA5C, 0xAA5F), (0xAADE, 0xAADF), (0xAAF0, 0xAAF1), (0xABEB, 0xABEB),
+    (0xFD3E, 0xFD3F), (0xFE10, 0xFE19), (0xFE30, 0xFE52), (0xFE54, 0xFE61),
+    (0xFE63, 0xFE63), (0xFE68, 0xFE68), (0xFE6A, 0xFE6B), (0xFF01, 0xFF03),
+    (0xFF05, 0xFF0A), (0xFF0C, 0xFF0F), (0xFF1A, 0xFF1B), (0xFF1F, 0xFF20),
+    (0xFF3B, 0xFF3D), (0xFF3F, 0xFF3F), (0xFF5B, 0xFF5B), (0xFF5D, 0xFF5D),
+    (0xFF5F, 0xFF65), (0x10100, 0x10102), (0x1039F, 0x1039F),
+    (0x103D0, 0x103D0), (0x1056F, 0x1056F), (0x10857, 0x10857),
+    (0x1091F, 0x1091F), (0x1093F, 0x1093F), (0x10A50, 0x10A58),
+    (0x10A7F, 0x10A7F), (0x10AF0, 0x10AF6), (0x10B39, 0x10B3F),
+    (0x10B99, 0x10B9C), (0x11047, 0x1104D), (0x110BB, 0x110BC),
+    (0x110BE, 0x110C1), (0x11140, 0x11143), (0x11174, 0x11175),
+    (0x111C5, 0x111C8), (0x111CD, 0x111CD), (0x11238, 0x1123D),
+    (0x114C6, 0x114C6), (0x115C1, 0x115C9), (0x11641, 0x11643),
+    (0x12470, 0x12474), (0x16A6E, 0x16A6F), (0x16AF5, 0x16AF5),
+    (0x16B37, 0x16B3B), (0x16B44, 0x16B44), (0x1BC9F, 0x1BC9F),
+]
+
+PUNCT_BLOCK_BITS = 8
+FOLD_BLOCK_BITS = 7
+
+def two_level(values, block_bits, default):
+    """Split 'values' into deduplicated blocks of 2**block_bits entries.
+    Returns (index, blocks)."""
+    size = 1 << block_bits
+    limit = (len(values) + size - 1) // size * size
+    values = values + [default] * (limit - len(values))
+    index, blocks, seen = [], [], {}
+    for start in range(0, limit, size):
+        block = tuple(values[start:start + size])
+        if block not in seen:
+            seen[block] = len(blocks)
+            blocks.append(block)
+        index.append(seen[block])
+    return index, blocks, limit
+
+def print_array(ctype, name, values, per_line=12):
+    print("static const %s %s[] = {" % (ctype, name))
+    for i in range(0, len(values), per_line):
+        print('  ' + ', '.join(map(str, values[i:i + per_line])) + ',')
+    print("};\n")
+
+# Case folding: for every code point, the offset of its folded UTF-8 form
+# in cmark_case_fold_utf8, where the first byte holds the length.  Offset 0
+# means the code point folds to itself.
+folds = {}
+for line in sys.stdin:
+    if not line[:1] or line[0] not in '0123456789ABCDEF':
+        continue
+    fields = [f.strip() for f in line.split(';')]
+    char, status, mapping = int(fields[0], 16), fields[1], fields[2]
+    if status in ('C', 'F') and char not in folds:
+        folds[char] = ''.join(chr(int(c, 16)) for c in mapping.split()).encode('utf-8')
+
+pool = [0]
+offsets = {}
+fold_values = [0] * (max(folds) + 1)
+for char in sorted(folds):
+    bs = folds[char]
+    if bs not in offsets:
+        offsets[bs] = len(pool)
+        pool.append(len(bs))
+        pool.extend(bs)
+    fold_values[char] = offsets[bs]
+
+fold_index, fold_blocks, fold_limit = two_level(fold_values, FOLD_BLOCK_BITS, 0)
+
+# Punctuation: one bit per code point.
+punct_max = max(b for _, b in PUNCTUATION_RANGES)
+bits = [0] * (punct_max + 1)
+for a, b in PUNCTUATION_RANGES:
+    for c in range(a, b + 1):
+        bits[c] = 1
+punct_index, punct_blocks, punct_limit = two_level(bits, PUNCT_BLOCK_BITS, 0)
+
+assert len(fold_blocks) < 256 and len(punct_blocks) < 256 and len(pool) < 65536
+# cmark_utf8proc_case_fold reserves 16 bytes per folded code point.
+assert max(len(bs) for bs in folds.values()) < 16
+
+print("/* Autogenerated by tools/make_unicode_tables.py */\n")
+
+print("#define CMARK_CASE_FOLD_BLOCK_BITS %d" % FOLD_BLOCK_BITS)
+print("#define CMARK_CASE_FOLD_LIMIT 0x%X" % fold_limit)
+print("#define CMARK_PUNCT_BLOCK_BITS %d" % PUNCT_BLOCK_BITS)
+print("#define CMARK_PUNCT_LIMIT 0x%X\n" % punct_limit)
+
+print_array("uint8_t", "cmark_case_fold_index", fold_index)
+print_array("uint16_t", "cmark_case_fold_blocks",
+            [v for block in fold_blocks for v in block])
+print_array("uint8_t", "cmark_case_fold_utf8", pool)
+
+print_array("uint8_t", "cmark_punct_index", punct_index)
+punct_bytes = []
+for block in punct_blocks:
+    for i in range(0, len(block), 8):
+        punct_bytes.append(sum(bit << j for j, bit in enumerate(block[i:i + 8])))
+print_array("uint8_t", "cmark_punct_blocks", punct_bytes)